@@ -0,0 +1,207 @@
+/* RISC-V checksum routines include file.
+
+   Copyright (C) 2023 Free Software Foundation, Inc.
+
+   This file is part of GCC.
+
+   GCC is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published
+   by the Free Software Foundation; either version 3, or (at your
+   option) any later version.
+
+   GCC is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+   or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+   License for more details.
+
+   Under Section 7 of GPL version 3, you are granted additional
+   permissions described in the GCC Runtime Library Exception, version
+   3.1, as published by the Free Software Foundation.
+
+   You should have received a copy of the GNU General Public License and
+   a copy of the GCC Runtime Library Exception along with this program;
+   see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+   <http://www.gnu.org/licenses/>.  */
+
+#ifndef _GCC_RISCV_CRC_H
+#define _GCC_RISCV_CRC_H 1
+
+/* CRC-32 (ISO-HDLC, as in zlib and Ethernet), CRC-32C (Castagnoli, as in
+   iSCSI and ext4) and Adler-32.  All three take the running value as the
+   first argument and have zlib's conventions: start a CRC with 0 and an
+   Adler-32 with 1.
+
+   On RV64 with Zbc the CRCs consume eight bytes per step with a Barrett
+   reduction built from clmul/clmulr; otherwise they fall back to a
+   nibble-wide table.  Adler-32 accumulates one vector register of bytes
+   per step when the V extension is available.  */
+
+#include <stdint.h>
+#include <stddef.h>
+#ifdef __riscv_vector
+#include <riscv_vector.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __RISCV_CRC32_POLY	0xedb88320u
+#define __RISCV_CRC32C_POLY	0x82f63b78u
+/* Bit-reflected quotient x^96 / P(x), less its implicit x^64 term.  */
+#define __RISCV_CRC32_QT	0x5a72d812fb808b20ull
+#define __RISCV_CRC32C_QT	0xa434f61c6f5389f8ull
+
+#define __RISCV_ADLER32_BASE	65521u
+/* Largest n such that 255 n (n + 1) / 2 + (n + 1) (BASE - 1) fits in
+   32 bits, so the sums need reducing only once every n bytes.  */
+#define __RISCV_ADLER32_NMAX	5552u
+
+__extension__ static __inline uint32_t
+__riscv_crc32_bytes (uint32_t __crc, const unsigned char *__p, size_t __len,
+		     uint32_t __poly)
+{
+  static const uint32_t __crc32_tab[16] = {
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+    0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+    0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+  };
+  static const uint32_t __crc32c_tab[16] = {
+    0x00000000, 0x105ec76f, 0x20bd8ede, 0x30e349b1,
+    0x417b1dbc, 0x5125dad3, 0x61c69362, 0x7198540d,
+    0x82f63b78, 0x92a8fc17, 0xa24bb5a6, 0xb21572c9,
+    0xc38d26c4, 0xd3d3e1ab, 0xe330a81a, 0xf36e6f75
+  };
+  const uint32_t *__tab
+    = __poly == __RISCV_CRC32_POLY ? __crc32_tab : __crc32c_tab;
+
+  while (__len--)
+    {
+      __crc ^= *__p++;
+      __crc = (__crc >> 4) ^ __tab[__crc & 15];
+      __crc = (__crc >> 4) ^ __tab[__crc & 15];
+    }
+  return __crc;
+}
+
+__extension__ static __inline uint32_t
+__riscv_crc32_update (uint32_t __crc, const void *__buf, size_t __len,
+		      uint32_t __poly, uint64_t __qt)
+{
+  const unsigned char *__p = (const unsigned char *) __buf;
+
+  __crc = ~__crc;
+#if defined (__riscv_zbc) && __riscv_xlen == 64
+  if (__len >= 16)
+    {
+      size_t __head = -(uintptr_t) __p & 7;
+
+      __crc = __riscv_crc32_bytes (__crc, __p, __head, __poly);
+      __p += __head;
+      __len -= __head;
+      for (; __len >= 8; __p += 8, __len -= 8)
+	{
+	  uint64_t __s, __t;
+
+	  __builtin_memcpy (&__s, __p, 8);
+	  __s ^= __crc;
+	  /* __crc = __s * x^32 mod P, by Barrett reduction.  clmulr of the
+	     reflected operands gives the high half of the product.  */
+	  __asm__ ("clmul\t%0, %1, %2\n\t"
+		   "slli\t%0, %0, 1\n\t"
+		   "xor\t%0, %0, %1\n\t"
+		   "clmulr\t%0, %0, %3\n\t"
+		   "srli\t%0, %0, 32"
+		   : "=&r" (__t)
+		   : "r" (__s), "r" (__qt), "r" ((uint64_t) __poly << 32));
+	  __crc = (uint32_t) __t;
+	}
+    }
+#else
+  (void) __qt;
+#endif
+  return ~__riscv_crc32_bytes (__crc, __p, __len, __poly);
+}
+
+__extension__ static __inline uint32_t
+__riscv_crc32 (uint32_t __crc, const void *__buf, size_t __len)
+{
+  return __riscv_crc32_update (__crc, __buf, __len, __RISCV_CRC32_POLY,
+			       __RISCV_CRC32_QT);
+}
+
+__extension__ static __inline uint32_t
+__riscv_crc32c (uint32_t __crc, const void *__buf, size_t __len)
+{
+  return __riscv_crc32_update (__crc, __buf, __len, __RISCV_CRC32C_POLY,
+			       __RISCV_CRC32C_QT);
+}
+
+__extension__ static __inline uint32_t
+__riscv_adler32 (uint32_t __adler, const void *__buf, size_t __len)
+{
+  const unsigned char *__p = (const unsigned char *) __buf;
+  uint32_t __s1 = __adler & 0xffff, __s2 = __adler >> 16;
+  size_t __n;
+
+#ifdef __riscv_vector
+  /* Lane I of __v1 sums the bytes at offsets I mod W of the block and
+     __v2 accumulates __v1 before each step, so for a block of N = C W
+     bytes
+       s1 += sum (__v1)
+       s2 += N s1 + W sum (__v2) + sum ((W - I) __v1[I]).  */
+  const size_t __w = vsetvlmax_e8m1 ();
+  const size_t __cmax = __RISCV_ADLER32_NMAX / __w;
+
+  while (__cmax > 0 && __len >= __w)
+    {
+      size_t __c = __len / __w < __cmax ? __len / __w : __cmax;
+      vuint32m4_t __v1 = vmv_v_x_u32m4 (0, __w), __v2 = __v1;
+      vuint32m1_t __z = vmv_v_x_u32m1 (0, __w);
+      uint32_t __sum1, __sum2, __sumw;
+
+      __n = __c * __w;
+      for (; __c > 0; __c--, __p += __w)
+	{
+	  __v2 = vadd_vv_u32m4 (__v2, __v1, __w);
+	  __v1 = vwaddu_wv_u32m4 (__v1, vwaddu_vx_u16m2 (vle8_v_u8m1 (__p, __w),
+							 0, __w), __w);
+	}
+      __sum1 = vmv_x_s_u32m1_u32 (vredsum_vs_u32m4_u32m1 (__z, __v1, __z,
+							  __w));
+      __sum2 = vmv_x_s_u32m1_u32 (vredsum_vs_u32m4_u32m1 (__z, __v2, __z,
+							  __w));
+      __sumw = vmv_x_s_u32m1_u32 (
+	vredsum_vs_u32m4_u32m1 (__z,
+				vmul_vv_u32m4 (__v1,
+					       vrsub_vx_u32m4 (vid_v_u32m4 (__w),
+							       __w, __w),
+					       __w),
+				__z, __w));
+      __s2 = (__s2 + (uint64_t) __n * __s1 + (uint64_t) __w * __sum2 + __sumw)
+	     % __RISCV_ADLER32_BASE;
+      __s1 = (__s1 + __sum1) % __RISCV_ADLER32_BASE;
+      __len -= __n;
+    }
+#endif
+  while (__len > 0)
+    {
+      __n = __len < __RISCV_ADLER32_NMAX ? __len : __RISCV_ADLER32_NMAX;
+      __len -= __n;
+      while (__n--)
+	{
+	  __s1 += *__p++;
+	  __s2 += __s1;
+	}
+      __s1 %= __RISCV_ADLER32_BASE;
+      __s2 %= __RISCV_ADLER32_BASE;
+    }
+  return (__s2 << 16) | __s1;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _GCC_RISCV_CRC_H */
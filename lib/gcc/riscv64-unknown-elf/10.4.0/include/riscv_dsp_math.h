@@ -0,0 +1,1627 @@
+/* RISC-V fixed-point DSP routines include file.
+
+   Copyright (C) 2023 Free Software Foundation, Inc.
+
+   This file is part of GCC.
+
+   GCC is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published
+   by the Free Software Foundation; either version 3, or (at your
+   option) any later version.
+
+   GCC is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+   or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+   License for more details.
+
+   Under Section 7 of GPL version 3, you are granted additional
+   permissions described in the GCC Runtime Library Exception, version
+   3.1, as published by the Free Software Foundation.
+
+   You should have received a copy of the GNU General Public License and
+   a copy of the GCC Runtime Library Exception along with this program;
+   see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+   <http://www.gnu.org/licenses/>.  */
+
+#ifndef _GCC_RISCV_DSP_MATH_H
+#define _GCC_RISCV_DSP_MATH_H 1
+
+/* Q7, Q15 and Q31 kernels built on the packed-SIMD intrinsics of
+   <riscv-dsp.h>: scalar Q-format arithmetic, saturating vector
+   arithmetic, dot products, statistics, FIR and biquad filters and
+   matrix operations.  The argument order, coefficient layouts and
+   accumulator formats follow the CMSIS-DSP functions of the same names,
+   so code written against those ports by renaming.
+
+   Each step consumes one XLEN register of lanes: two Q15 or four Q7
+   samples on RV32, four Q15 or eight Q7 samples on RV64.  Q15 products
+   accumulate into 64 bits with smalda when Zpsfoperand is available and
+   through kmda otherwise; Q31 products use smar64 on RV32 with
+   Zpsfoperand and a plain 64-bit multiply-add elsewhere.  Trailing
+   elements go through the same instruction on a zero-padded register, so
+   the result does not depend on where the block boundary falls.  */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <riscv-dsp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int8_t q7_t;
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+typedef int64_t q63_t;
+
+#define __RISCV_DSP_OK			0
+#define __RISCV_DSP_SIZE_MISMATCH	(-1)
+
+#if __riscv_xlen == 64
+#define __RISCV_DSP_LANES_q7	8
+#define __RISCV_DSP_LANES_q15	4
+#define __RISCV_DSP_LANES_q31	2
+#define __RISCV_DSP_LANES_u8	8
+typedef uint8x8_t __riscv_dsp_u8xn_t;
+typedef int8x8_t __riscv_dsp_q7xn_t;
+typedef int16x4_t __riscv_dsp_q15xn_t;
+typedef int32x2_t __riscv_dsp_q31xn_t;
+#else
+#define __RISCV_DSP_LANES_q7	4
+#define __RISCV_DSP_LANES_q15	2
+#define __RISCV_DSP_LANES_q31	1
+#define __RISCV_DSP_LANES_u8	4
+typedef uint8x4_t __riscv_dsp_u8xn_t;
+typedef int8x4_t __riscv_dsp_q7xn_t;
+typedef int16x2_t __riscv_dsp_q15xn_t;
+typedef int32_t __riscv_dsp_q31xn_t;
+#endif
+
+/* smaqa accumulates Q7 products into one 32-bit lane per four bytes.  */
+typedef __riscv_dsp_q31xn_t __riscv_dsp_acc_q7xn_t;
+
+/* Q31 lanes: RV64 packs two per register, RV32 has the W forms.  */
+#if __riscv_xlen == 64
+#define __riscv_dsp_kadd_q31xn		__rv__v_kadd32
+#define __riscv_dsp_ksub_q31xn		__rv__v_ksub32
+#define __riscv_dsp_kabs_q31xn		__rv__v_kabs32
+#define __riscv_dsp_kwmmul_q31xn	__rv__v_kwmmul
+#define __riscv_dsp_kslra_q31xn		__rv__v_kslra32
+#define __riscv_dsp_smax_q31xn		__rv__v_smax32
+#define __riscv_dsp_smin_q31xn		__rv__v_smin32
+#else
+#define __riscv_dsp_kadd_q31xn		__rv__kaddw
+#define __riscv_dsp_ksub_q31xn		__rv__ksubw
+#define __riscv_dsp_kabs_q31xn		__rv__kabsw
+#define __riscv_dsp_kwmmul_q31xn	__rv__kwmmul
+#define __riscv_dsp_kslra_q31xn		__rv__kslraw
+#define __riscv_dsp_smax_q31xn		__rv__maxw
+#define __riscv_dsp_smin_q31xn		__rv__minw
+#endif
+
+#define __riscv_dsp_kadd_q7xn		__rv__v_kadd8
+#define __riscv_dsp_ksub_q7xn		__rv__v_ksub8
+#define __riscv_dsp_kabs_q7xn		__rv__v_kabs8
+#define __riscv_dsp_khm_q7xn		__rv__v_khm8
+#define __riscv_dsp_kslra_q7xn		__rv__v_kslra8
+#define __riscv_dsp_smax_q7xn		__rv__v_smax8
+#define __riscv_dsp_smin_q7xn		__rv__v_smin8
+
+#define __riscv_dsp_kadd_q15xn		__rv__v_kadd16
+#define __riscv_dsp_ksub_q15xn		__rv__v_ksub16
+#define __riscv_dsp_kabs_q15xn		__rv__v_kabs16
+#define __riscv_dsp_khm_q15xn		__rv__v_khm16
+#define __riscv_dsp_kslra_q15xn		__rv__v_kslra16
+#define __riscv_dsp_smax_q15xn		__rv__v_smax16
+#define __riscv_dsp_smin_q15xn		__rv__v_smin16
+
+#define __riscv_dsp_khm_q31xn		__riscv_dsp_kwmmul_q31xn
+
+#define __riscv_dsp_kadd_u8xn		__rv__v_ukadd8
+#define __riscv_dsp_ksub_u8xn		__rv__v_uksub8
+#define __riscv_dsp_hadd_u8xn		__rv__v_uradd8
+
+/* Unaligned register loads and stores.  The _n forms move only the first
+   N lanes and zero the rest.  */
+#define __RISCV_DSP_LOADSTORE(SFX, T)					\
+__extension__ static __inline __riscv_dsp_##SFX##xn_t			\
+__riscv_dsp_load_##SFX (const T *__p)					\
+{									\
+  __riscv_dsp_##SFX##xn_t __v;						\
+  __builtin_memcpy (&__v, __p, sizeof (__v));				\
+  return __v;								\
+}									\
+									\
+__extension__ static __inline __riscv_dsp_##SFX##xn_t			\
+__riscv_dsp_load_##SFX##_n (const T *__p, size_t __n)			\
+{									\
+  __riscv_dsp_##SFX##xn_t __v;						\
+  __builtin_memset (&__v, 0, sizeof (__v));				\
+  __builtin_memcpy (&__v, __p, __n * sizeof (T));			\
+  return __v;								\
+}									\
+									\
+__extension__ static __inline void					\
+__riscv_dsp_store_##SFX (T *__p, __riscv_dsp_##SFX##xn_t __v)		\
+{									\
+  __builtin_memcpy (__p, &__v, sizeof (__v));				\
+}									\
+									\
+__extension__ static __inline void					\
+__riscv_dsp_store_##SFX##_n (T *__p, __riscv_dsp_##SFX##xn_t __v,	\
+			     size_t __n)				\
+{									\
+  __builtin_memcpy (__p, &__v, __n * sizeof (T));			\
+}									\
+									\
+__extension__ static __inline __riscv_dsp_##SFX##xn_t			\
+__riscv_dsp_dup_##SFX (T __x)						\
+{									\
+  __riscv_dsp_##SFX##xn_t __v;						\
+  T __a[__RISCV_DSP_LANES_##SFX];					\
+  size_t __i;								\
+									\
+  for (__i = 0; __i < __RISCV_DSP_LANES_##SFX; __i++)			\
+    __a[__i] = __x;							\
+  __builtin_memcpy (&__v, __a, sizeof (__v));				\
+  return __v;								\
+}
+
+__RISCV_DSP_LOADSTORE (u8, uint8_t)
+__RISCV_DSP_LOADSTORE (q7, q7_t)
+__RISCV_DSP_LOADSTORE (q15, q15_t)
+__RISCV_DSP_LOADSTORE (q31, q31_t)
+
+__extension__ static __inline q7_t
+__riscv_dsp_sat_q7 (q63_t __x)
+{
+  return __x > INT8_MAX ? INT8_MAX : __x < INT8_MIN ? INT8_MIN : (q7_t) __x;
+}
+
+__extension__ static __inline q15_t
+__riscv_dsp_sat_q15 (q63_t __x)
+{
+  return (__x > INT16_MAX ? INT16_MAX
+	  : __x < INT16_MIN ? INT16_MIN : (q15_t) __x);
+}
+
+__extension__ static __inline q31_t
+__riscv_dsp_sat_q31 (q63_t __x)
+{
+  return (__x > INT32_MAX ? INT32_MAX
+	  : __x < INT32_MIN ? INT32_MIN : (q31_t) __x);
+}
+
+/* Negation saturates -1.0 to the largest positive value.  */
+__extension__ static __inline __riscv_dsp_q7xn_t
+__riscv_dsp_kneg_q7xn (__riscv_dsp_q7xn_t __a)
+{
+  return __riscv_dsp_ksub_q7xn (__riscv_dsp_dup_q7 (0), __a);
+}
+
+__extension__ static __inline __riscv_dsp_q15xn_t
+__riscv_dsp_kneg_q15xn (__riscv_dsp_q15xn_t __a)
+{
+  return __riscv_dsp_ksub_q15xn (__riscv_dsp_dup_q15 (0), __a);
+}
+
+__extension__ static __inline __riscv_dsp_q31xn_t
+__riscv_dsp_kneg_q31xn (__riscv_dsp_q31xn_t __a)
+{
+  return __riscv_dsp_ksub_q31xn (__riscv_dsp_dup_q31 (0), __a);
+}
+
+/* ACC + sum (A[i] * B[i]) over one register of Q15 lanes.  Without
+   Zpsfoperand the pairs go through kmda, which saturates the single case
+   where both products are (-1.0)^2.  */
+__extension__ static __inline q63_t
+__riscv_dsp_mac_q15 (q63_t __acc, __riscv_dsp_q15xn_t __a,
+		     __riscv_dsp_q15xn_t __b)
+{
+#if __riscv_zpsfoperand
+  return __rv__v_smalda (__acc, __a, __b);
+#elif __riscv_xlen == 64
+  int32x2_t __s = __rv__v_kmda (__a, __b);
+  return __acc + __s[0] + __s[1];
+#else
+  return __acc + __rv__v_kmda (__a, __b);
+#endif
+}
+
+/* ACC + A * B for one pair of Q31 values.  */
+__extension__ static __inline q63_t
+__riscv_dsp_mac_q31 (q63_t __acc, q31_t __a, q31_t __b)
+{
+#if __riscv_zpsfoperand && __riscv_xlen == 32
+  return __rv__smar64 (__acc, __a, __b);
+#else
+  return __acc + (q63_t) __a * __b;
+#endif
+}
+
+__extension__ static __inline q31_t
+__riscv_dsp_hsum_acc_q7xn (__riscv_dsp_acc_q7xn_t __acc)
+{
+#if __riscv_xlen == 64
+  return __acc[0] + __acc[1];
+#else
+  return __acc;
+#endif
+}
+
+/* Scalar Q-format arithmetic, one P instruction apiece where the
+   extension has one.  These are the operations ISO/IEC TR 18037 gives
+   the saturating fixed-point types, on their integer representations:
+   _Sat short _Fract, _Sat _Fract and _Sat long _Fract correspond to Q7,
+   Q15 and Q31, and a 32-bit _Sat _Accum adds and subtracts as Q31.  The
+   qrshr functions round to nearest, ties up; everything else truncates
+   toward minus infinity.  SHIFT lies in [-8, 7], [-16, 15] or
+   [-32, 31], negative values shifting right.  */
+
+__extension__ static __inline q7_t
+__riscv_dsp_qadd_q7 (q7_t __a, q7_t __b)
+{
+  return (q7_t) __rv__sclip32 ((intXLEN_t) __a + __b, 7);
+}
+
+__extension__ static __inline q15_t
+__riscv_dsp_qadd_q15 (q15_t __a, q15_t __b)
+{
+  return (q15_t) __rv__kaddh (__a, __b);
+}
+
+__extension__ static __inline q31_t
+__riscv_dsp_qadd_q31 (q31_t __a, q31_t __b)
+{
+  return (q31_t) __rv__kaddw (__a, __b);
+}
+
+__extension__ static __inline q7_t
+__riscv_dsp_qsub_q7 (q7_t __a, q7_t __b)
+{
+  return (q7_t) __rv__sclip32 ((intXLEN_t) __a - __b, 7);
+}
+
+__extension__ static __inline q15_t
+__riscv_dsp_qsub_q15 (q15_t __a, q15_t __b)
+{
+  return (q15_t) __rv__ksubh (__a, __b);
+}
+
+__extension__ static __inline q31_t
+__riscv_dsp_qsub_q31 (q31_t __a, q31_t __b)
+{
+  return (q31_t) __rv__ksubw (__a, __b);
+}
+
+__extension__ static __inline q7_t
+__riscv_dsp_qmul_q7 (q7_t __a, q7_t __b)
+{
+  return (q7_t) __rv__sclip32 (((intXLEN_t) __a * __b) >> 7, 7);
+}
+
+__extension__ static __inline q15_t
+__riscv_dsp_qmul_q15 (q15_t __a, q15_t __b)
+{
+  return (q15_t) __rv__khmbb ((uint32_t) __a, (uint32_t) __b);
+}
+
+__extension__ static __inline q31_t
+__riscv_dsp_qmul_q31 (q31_t __a, q31_t __b)
+{
+  return (q31_t) __rv__kwmmul (__a, __b);
+}
+
+/* The full Q31 product of two Q15 values, and that product added to
+   ACC, each saturated.  */
+__extension__ static __inline q31_t
+__riscv_dsp_qmull_q15 (q15_t __a, q15_t __b)
+{
+  return __rv__kdmbb ((uint32_t) __a, (uint32_t) __b);
+}
+
+__extension__ static __inline q31_t
+__riscv_dsp_qmla_q15 (q31_t __acc, q15_t __a, q15_t __b)
+{
+  return __rv__kdmabb (__acc, (uint32_t) __a, (uint32_t) __b);
+}
+
+__extension__ static __inline q7_t
+__riscv_dsp_qabs_q7 (q7_t __a)
+{
+  return (q7_t) __rv__sclip32 (__rv__kabsw (__a), 7);
+}
+
+__extension__ static __inline q15_t
+__riscv_dsp_qabs_q15 (q15_t __a)
+{
+  return (q15_t) __rv__sclip32 (__rv__kabsw (__a), 15);
+}
+
+__extension__ static __inline q31_t
+__riscv_dsp_qabs_q31 (q31_t __a)
+{
+  return __rv__kabsw (__a);
+}
+
+/* Shifting the value up to the top of a word lets kslraw saturate at the
+   narrower type's bounds.  */
+__extension__ static __inline q7_t
+__riscv_dsp_qshl_q7 (q7_t __a, int8_t __shift)
+{
+  return (q7_t) ((q31_t) __rv__kslraw ((q31_t) __a * (1 << 24), __shift)
+		 >> 24);
+}
+
+__extension__ static __inline q15_t
+__riscv_dsp_qshl_q15 (q15_t __a, int8_t __shift)
+{
+  return (q15_t) ((q31_t) __rv__kslraw ((q31_t) __a * (1 << 16), __shift)
+		  >> 16);
+}
+
+__extension__ static __inline q31_t
+__riscv_dsp_qshl_q31 (q31_t __a, int8_t __shift)
+{
+  return (q31_t) __rv__kslraw (__a, __shift);
+}
+
+__extension__ static __inline q15_t
+__riscv_dsp_qrshr_q15 (q15_t __a, uint8_t __shift)
+{
+  return (q15_t) __rv__sra_u (__a, __shift);
+}
+
+__extension__ static __inline q31_t
+__riscv_dsp_qrshr_q31 (q31_t __a, uint8_t __shift)
+{
+  return (q31_t) __rv__sra_u (__a, __shift);
+}
+
+/* Conversions.  Narrowing rounds and saturates.  */
+__extension__ static __inline q15_t
+__riscv_dsp_q31_to_q15 (q31_t __a)
+{
+  return (q15_t) __rv__sclip32 (__rv__sra_u (__a, 16), 15);
+}
+
+__extension__ static __inline q7_t
+__riscv_dsp_q15_to_q7 (q15_t __a)
+{
+  return (q7_t) __rv__sclip32 (__rv__sra_u (__a, 8), 7);
+}
+
+__extension__ static __inline q31_t
+__riscv_dsp_q15_to_q31 (q15_t __a)
+{
+  return (q31_t) __a * (1 << 16);
+}
+
+__extension__ static __inline q15_t
+__riscv_dsp_q7_to_q15 (q7_t __a)
+{
+  return (q15_t) (__a * (1 << 8));
+}
+
+/* The number of redundant sign bits, the normalisation shift that
+   TR 18037 calls countls.  */
+__extension__ static __inline unsigned int
+__riscv_dsp_countls_q15 (q15_t __a)
+{
+  return (uint32_t) __rv__clrs32 (__a) - 16;
+}
+
+__extension__ static __inline unsigned int
+__riscv_dsp_countls_q31 (q31_t __a)
+{
+  return (uint32_t) __rv__clrs32 (__a);
+}
+
+/* Elementwise kernels.  */
+
+#define __RISCV_DSP_BINARY(NAME, SFX, T, OP)				\
+__extension__ static __inline void					\
+__riscv_dsp_##NAME##_##SFX (const T *__a, const T *__b, T *__dst,	\
+			     size_t __n)				\
+{									\
+  const size_t __l = __RISCV_DSP_LANES_##SFX;				\
+									\
+  for (; __n >= __l; __n -= __l, __a += __l, __b += __l, __dst += __l)	\
+    __riscv_dsp_store_##SFX (__dst, OP (__riscv_dsp_load_##SFX (__a),	\
+					__riscv_dsp_load_##SFX (__b)));	\
+  if (__n > 0)								\
+    __riscv_dsp_store_##SFX##_n (__dst,					\
+				 OP (__riscv_dsp_load_##SFX##_n (__a, __n), \
+				     __riscv_dsp_load_##SFX##_n (__b, __n)), \
+				 __n);					\
+}
+
+#define __RISCV_DSP_UNARY(NAME, SFX, T, OP)				\
+__extension__ static __inline void					\
+__riscv_dsp_##NAME##_##SFX (const T *__src, T *__dst, size_t __n)	\
+{									\
+  const size_t __l = __RISCV_DSP_LANES_##SFX;				\
+									\
+  for (; __n >= __l; __n -= __l, __src += __l, __dst += __l)		\
+    __riscv_dsp_store_##SFX (__dst, OP (__riscv_dsp_load_##SFX (__src))); \
+  if (__n > 0)								\
+    __riscv_dsp_store_##SFX##_n (__dst,					\
+				 OP (__riscv_dsp_load_##SFX##_n (__src, __n)), \
+				 __n);					\
+}
+
+/* DST[i] = sat (A[i] + B[i]), sat (A[i] - B[i]), sat (A[i] * B[i]).  */
+__RISCV_DSP_BINARY (add, q7, q7_t, __riscv_dsp_kadd_q7xn)
+__RISCV_DSP_BINARY (add, q15, q15_t, __riscv_dsp_kadd_q15xn)
+__RISCV_DSP_BINARY (add, q31, q31_t, __riscv_dsp_kadd_q31xn)
+__RISCV_DSP_BINARY (sub, q7, q7_t, __riscv_dsp_ksub_q7xn)
+__RISCV_DSP_BINARY (sub, q15, q15_t, __riscv_dsp_ksub_q15xn)
+__RISCV_DSP_BINARY (sub, q31, q31_t, __riscv_dsp_ksub_q31xn)
+__RISCV_DSP_BINARY (mult, q7, q7_t, __riscv_dsp_khm_q7xn)
+__RISCV_DSP_BINARY (mult, q15, q15_t, __riscv_dsp_khm_q15xn)
+__RISCV_DSP_BINARY (mult, q31, q31_t, __riscv_dsp_khm_q31xn)
+
+/* DST[i] = sat (|SRC[i]|), sat (-SRC[i]).  */
+__RISCV_DSP_UNARY (abs, q7, q7_t, __riscv_dsp_kabs_q7xn)
+__RISCV_DSP_UNARY (abs, q15, q15_t, __riscv_dsp_kabs_q15xn)
+__RISCV_DSP_UNARY (abs, q31, q31_t, __riscv_dsp_kabs_q31xn)
+__RISCV_DSP_UNARY (negate, q7, q7_t, __riscv_dsp_kneg_q7xn)
+__RISCV_DSP_UNARY (negate, q15, q15_t, __riscv_dsp_kneg_q15xn)
+__RISCV_DSP_UNARY (negate, q31, q31_t, __riscv_dsp_kneg_q31xn)
+
+/* DST[i] = sat (SRC[i] << SHIFT), or SRC[i] >> -SHIFT for a negative
+   SHIFT.  SHIFT must lie in [-8, 7], [-16, 15] or [-32, 31]
+   respectively.  DST[i] = sat (sat (SRC[i] * SCALE) << SHIFT) for the
+   scale functions, so a fractional SCALE and a power-of-two SHIFT
+   together give gains beyond 1.0.  */
+#define __RISCV_DSP_SHIFT_SCALE(SFX, T)					\
+__extension__ static __inline void					\
+__riscv_dsp_shift_##SFX (const T *__src, int8_t __shift, T *__dst,	\
+			 size_t __n)					\
+{									\
+  const size_t __l = __RISCV_DSP_LANES_##SFX;				\
+									\
+  for (; __n >= __l; __n -= __l, __src += __l, __dst += __l)		\
+    __riscv_dsp_store_##SFX (__dst,					\
+			     __riscv_dsp_kslra_##SFX##xn (		\
+			       __riscv_dsp_load_##SFX (__src), __shift)); \
+  if (__n > 0)								\
+    __riscv_dsp_store_##SFX##_n (__dst,					\
+				 __riscv_dsp_kslra_##SFX##xn (		\
+				   __riscv_dsp_load_##SFX##_n (__src, __n), \
+				   __shift),				\
+				 __n);					\
+}									\
+									\
+__extension__ static __inline void					\
+__riscv_dsp_scale_##SFX (const T *__src, T __scale, int8_t __shift,	\
+			 T *__dst, size_t __n)				\
+{									\
+  const size_t __l = __RISCV_DSP_LANES_##SFX;				\
+  const __riscv_dsp_##SFX##xn_t __s = __riscv_dsp_dup_##SFX (__scale);	\
+									\
+  for (; __n >= __l; __n -= __l, __src += __l, __dst += __l)		\
+    __riscv_dsp_store_##SFX (__dst,					\
+			     __riscv_dsp_kslra_##SFX##xn (		\
+			       __riscv_dsp_khm_##SFX##xn (		\
+				 __riscv_dsp_load_##SFX (__src), __s),	\
+			       __shift));				\
+  if (__n > 0)								\
+    __riscv_dsp_store_##SFX##_n (__dst,					\
+				 __riscv_dsp_kslra_##SFX##xn (		\
+				   __riscv_dsp_khm_##SFX##xn (		\
+				     __riscv_dsp_load_##SFX##_n (__src, __n), \
+				     __s),				\
+				   __shift),				\
+				 __n);					\
+}
+
+__RISCV_DSP_SHIFT_SCALE (q7, q7_t)
+__RISCV_DSP_SHIFT_SCALE (q15, q15_t)
+__RISCV_DSP_SHIFT_SCALE (q31, q31_t)
+
+/* 8-bit pixel kernels.  DST[i] = sat (A[i] + B[i]), sat (A[i] - B[i]),
+   (A[i] + B[i]) >> 1.  */
+__RISCV_DSP_BINARY (add, u8, uint8_t, __riscv_dsp_kadd_u8xn)
+__RISCV_DSP_BINARY (sub, u8, uint8_t, __riscv_dsp_ksub_u8xn)
+__RISCV_DSP_BINARY (avg, u8, uint8_t, __riscv_dsp_hadd_u8xn)
+
+/* DST[i] = SRC[i] > THRESH ? 255 : 0.  */
+__extension__ static __inline void
+__riscv_dsp_threshold_u8 (const uint8_t *__src, uint8_t __thresh,
+			  uint8_t *__dst, size_t __n)
+{
+  const size_t __l = __RISCV_DSP_LANES_u8;
+  const __riscv_dsp_u8xn_t __t = __riscv_dsp_dup_u8 (__thresh);
+
+  for (; __n >= __l; __n -= __l, __src += __l, __dst += __l)
+    __riscv_dsp_store_u8 (__dst,
+			  __rv__v_ucmplt8 (__t, __riscv_dsp_load_u8 (__src)));
+  if (__n > 0)
+    __riscv_dsp_store_u8_n (__dst,
+			    __rv__v_ucmplt8 (__t,
+					     __riscv_dsp_load_u8_n (__src,
+								    __n)),
+			    __n);
+}
+
+/* DST[i] = min (max (SRC[i], LO), HI).  */
+__extension__ static __inline __riscv_dsp_u8xn_t
+__riscv_dsp_clamp_u8xn (__riscv_dsp_u8xn_t __x, __riscv_dsp_u8xn_t __lo,
+			__riscv_dsp_u8xn_t __hi)
+{
+  return __rv__v_umin8 (__rv__v_umax8 (__x, __lo), __hi);
+}
+
+__extension__ static __inline void
+__riscv_dsp_clamp_u8 (const uint8_t *__src, uint8_t __lo, uint8_t __hi,
+		      uint8_t *__dst, size_t __n)
+{
+  const size_t __l = __RISCV_DSP_LANES_u8;
+  const __riscv_dsp_u8xn_t __vlo = __riscv_dsp_dup_u8 (__lo);
+  const __riscv_dsp_u8xn_t __vhi = __riscv_dsp_dup_u8 (__hi);
+
+  for (; __n >= __l; __n -= __l, __src += __l, __dst += __l)
+    __riscv_dsp_store_u8 (__dst,
+			  __riscv_dsp_clamp_u8xn (__riscv_dsp_load_u8 (__src),
+						  __vlo, __vhi));
+  if (__n > 0)
+    __riscv_dsp_store_u8_n (__dst,
+			    __riscv_dsp_clamp_u8xn (__riscv_dsp_load_u8_n
+						    (__src, __n),
+						    __vlo, __vhi),
+			    __n);
+}
+
+/* Audio mixing: DST[i] = sat (sat (A[i] * GAIN_A) + sat (B[i] * GAIN_B)),
+   the gains in Q15.  */
+__extension__ static __inline __riscv_dsp_q15xn_t
+__riscv_dsp_mix_q15xn (__riscv_dsp_q15xn_t __a, __riscv_dsp_q15xn_t __ga,
+		       __riscv_dsp_q15xn_t __b, __riscv_dsp_q15xn_t __gb)
+{
+  return __rv__v_kadd16 (__rv__v_khm16 (__a, __ga),
+			 __rv__v_khm16 (__b, __gb));
+}
+
+__extension__ static __inline void
+__riscv_dsp_mix_q15 (const q15_t *__a, q15_t __gain_a, const q15_t *__b,
+		     q15_t __gain_b, q15_t *__dst, size_t __n)
+{
+  const size_t __l = __RISCV_DSP_LANES_q15;
+  const __riscv_dsp_q15xn_t __ga = __riscv_dsp_dup_q15 (__gain_a);
+  const __riscv_dsp_q15xn_t __gb = __riscv_dsp_dup_q15 (__gain_b);
+
+  for (; __n >= __l; __n -= __l, __a += __l, __b += __l, __dst += __l)
+    __riscv_dsp_store_q15 (__dst,
+			   __riscv_dsp_mix_q15xn (__riscv_dsp_load_q15 (__a),
+						  __ga,
+						  __riscv_dsp_load_q15 (__b),
+						  __gb));
+  if (__n > 0)
+    __riscv_dsp_store_q15_n (__dst,
+			     __riscv_dsp_mix_q15xn (__riscv_dsp_load_q15_n
+						    (__a, __n), __ga,
+						    __riscv_dsp_load_q15_n
+						    (__b, __n), __gb),
+			     __n);
+}
+
+/* Dot products, in 18.14, 34.30 and 16.48 format respectively.  */
+
+__extension__ static __inline q31_t
+__riscv_dsp_dot_prod_q7 (const q7_t *__a, const q7_t *__b, size_t __n)
+{
+  const size_t __l = __RISCV_DSP_LANES_q7;
+  __riscv_dsp_acc_q7xn_t __acc = __riscv_dsp_dup_q31 (0);
+
+  for (; __n >= __l; __n -= __l, __a += __l, __b += __l)
+    __acc = __rv__v_smaqa (__acc, __riscv_dsp_load_q7 (__a),
+			   __riscv_dsp_load_q7 (__b));
+  if (__n > 0)
+    __acc = __rv__v_smaqa (__acc, __riscv_dsp_load_q7_n (__a, __n),
+			   __riscv_dsp_load_q7_n (__b, __n));
+  return __riscv_dsp_hsum_acc_q7xn (__acc);
+}
+
+__extension__ static __inline q63_t
+__riscv_dsp_dot_prod_q15 (const q15_t *__a, const q15_t *__b, size_t __n)
+{
+  const size_t __l = __RISCV_DSP_LANES_q15;
+  q63_t __acc = 0;
+
+  for (; __n >= __l; __n -= __l, __a += __l, __b += __l)
+    __acc = __riscv_dsp_mac_q15 (__acc, __riscv_dsp_load_q15 (__a),
+				 __riscv_dsp_load_q15 (__b));
+  if (__n > 0)
+    __acc = __riscv_dsp_mac_q15 (__acc, __riscv_dsp_load_q15_n (__a, __n),
+				 __riscv_dsp_load_q15_n (__b, __n));
+  return __acc;
+}
+
+__extension__ static __inline q63_t
+__riscv_dsp_dot_prod_q31 (const q31_t *__a, const q31_t *__b, size_t __n)
+{
+  q63_t __acc = 0;
+
+  while (__n--)
+    __acc += ((q63_t) *__a++ * *__b++) >> 14;
+  return __acc;
+}
+
+/* Statistics.  */
+
+/* *RESULT = the largest (smallest) element of SRC[0 .. N - 1], N > 0, and
+   *INDEX = the position of its first occurrence.  */
+#define __RISCV_DSP_MINMAX(NAME, SFX, T, OP, CMP)			\
+__extension__ static __inline void					\
+__riscv_dsp_##NAME##_##SFX (const T *__src, size_t __n, T *__result,	\
+			     size_t *__index)				\
+{									\
+  const size_t __l = __RISCV_DSP_LANES_##SFX;				\
+  __riscv_dsp_##SFX##xn_t __m = __riscv_dsp_dup_##SFX (__src[0]);	\
+  T __a[__RISCV_DSP_LANES_##SFX], __r;					\
+  size_t __i;								\
+									\
+  for (__i = 0; __i + __l <= __n; __i += __l)				\
+    __m = OP (__m, __riscv_dsp_load_##SFX (__src + __i));		\
+  __riscv_dsp_store_##SFX (__a, __m);					\
+  __r = __a[0];								\
+  for (; __i < __n; __i++)						\
+    if (__src[__i] CMP __r)						\
+      __r = __src[__i];							\
+  for (__i = 1; __i < __l; __i++)					\
+    if (__a[__i] CMP __r)						\
+      __r = __a[__i];							\
+  for (__i = 0; __src[__i] != __r; __i++)				\
+    ;									\
+  *__result = __r;							\
+  *__index = __i;							\
+}
+
+__RISCV_DSP_MINMAX (max, q7, q7_t, __riscv_dsp_smax_q7xn, >)
+__RISCV_DSP_MINMAX (max, q15, q15_t, __riscv_dsp_smax_q15xn, >)
+__RISCV_DSP_MINMAX (max, q31, q31_t, __riscv_dsp_smax_q31xn, >)
+__RISCV_DSP_MINMAX (min, q7, q7_t, __riscv_dsp_smin_q7xn, <)
+__RISCV_DSP_MINMAX (min, q15, q15_t, __riscv_dsp_smin_q15xn, <)
+__RISCV_DSP_MINMAX (min, q31, q31_t, __riscv_dsp_smin_q31xn, <)
+
+/* Means truncate toward zero, as the division does; N must be nonzero.
+   Multiplying by a register of ones turns the multiply-add into a
+   horizontal add.  */
+
+__extension__ static __inline q7_t
+__riscv_dsp_mean_q7 (const q7_t *__src, size_t __n)
+{
+  const size_t __l = __RISCV_DSP_LANES_q7;
+  const __riscv_dsp_q7xn_t __one = __riscv_dsp_dup_q7 (1);
+  __riscv_dsp_acc_q7xn_t __acc = __riscv_dsp_dup_q31 (0);
+  size_t __i = __n;
+
+  for (; __i >= __l; __i -= __l, __src += __l)
+    __acc = __rv__v_smaqa (__acc, __riscv_dsp_load_q7 (__src), __one);
+  if (__i > 0)
+    __acc = __rv__v_smaqa (__acc, __riscv_dsp_load_q7_n (__src, __i), __one);
+  return (q7_t) (__riscv_dsp_hsum_acc_q7xn (__acc) / (q31_t) __n);
+}
+
+__extension__ static __inline q15_t
+__riscv_dsp_mean_q15 (const q15_t *__src, size_t __n)
+{
+  const size_t __l = __RISCV_DSP_LANES_q15;
+  const __riscv_dsp_q15xn_t __one = __riscv_dsp_dup_q15 (1);
+  q63_t __acc = 0;
+  size_t __i = __n;
+
+  for (; __i >= __l; __i -= __l, __src += __l)
+    __acc = __riscv_dsp_mac_q15 (__acc, __riscv_dsp_load_q15 (__src), __one);
+  if (__i > 0)
+    __acc = __riscv_dsp_mac_q15 (__acc, __riscv_dsp_load_q15_n (__src, __i),
+				 __one);
+  return (q15_t) (__acc / (q63_t) __n);
+}
+
+__extension__ static __inline q31_t
+__riscv_dsp_mean_q31 (const q31_t *__src, size_t __n)
+{
+  q63_t __acc = 0;
+  size_t __i;
+
+  for (__i = 0; __i < __n; __i++)
+    __acc += __src[__i];
+  return (q31_t) (__acc / (q63_t) __n);
+}
+
+/* Sums of squares, in 18.14, 34.30 and 16.48 format.  */
+
+__extension__ static __inline q31_t
+__riscv_dsp_power_q7 (const q7_t *__src, size_t __n)
+{
+  return __riscv_dsp_dot_prod_q7 (__src, __src, __n);
+}
+
+__extension__ static __inline q63_t
+__riscv_dsp_power_q15 (const q15_t *__src, size_t __n)
+{
+  return __riscv_dsp_dot_prod_q15 (__src, __src, __n);
+}
+
+__extension__ static __inline q63_t
+__riscv_dsp_power_q31 (const q31_t *__src, size_t __n)
+{
+  return __riscv_dsp_dot_prod_q31 (__src, __src, __n);
+}
+
+/* Sample variance of SRC[0 .. N - 1], N > 1, in Q15.  */
+__extension__ static __inline q15_t
+__riscv_dsp_var_q15 (const q15_t *__src, size_t __n)
+{
+  const size_t __l = __RISCV_DSP_LANES_q15;
+  const __riscv_dsp_q15xn_t __one = __riscv_dsp_dup_q15 (1);
+  q63_t __sum = 0, __sumsq = 0;
+  size_t __i = __n;
+
+  if (__n <= 1)
+    return 0;
+  for (; __i > 0; __i -= __i < __l ? __i : __l, __src += __l)
+    {
+      __riscv_dsp_q15xn_t __x = __i >= __l ? __riscv_dsp_load_q15 (__src)
+				: __riscv_dsp_load_q15_n (__src, __i);
+
+      __sum = __riscv_dsp_mac_q15 (__sum, __x, __one);
+      __sumsq = __riscv_dsp_mac_q15 (__sumsq, __x, __x);
+    }
+  return (q15_t) ((__sumsq / (q63_t) (__n - 1)
+		   - __sum * __sum / (q63_t) (__n * (__n - 1))) >> 15);
+}
+
+/* FIR filters.  COEFFS holds the NUM_TAPS coefficients in time-reversed
+   order and STATE has room for NUM_TAPS + BLOCK_SIZE - 1 samples, where
+   BLOCK_SIZE is the largest block passed to the filter function.  The
+   Q7 and Q15 outputs are the saturated 18.14 and 34.30 sums; the Q31
+   output is the saturated 2.62 sum, so the coefficients must keep that
+   from overflowing.  SRC and DST may be the same buffer.  */
+
+#define __RISCV_DSP_FIR(SFX, T)						\
+typedef struct								\
+{									\
+  uint16_t __num_taps;							\
+  T *__state;								\
+  const T *__coeffs;							\
+} __riscv_dsp_fir_##SFX##_t;						\
+									\
+__extension__ static __inline void					\
+__riscv_dsp_fir_init_##SFX (__riscv_dsp_fir_##SFX##_t *__s,		\
+			    uint16_t __num_taps, const T *__coeffs,	\
+			    T *__state, size_t __block_size)		\
+{									\
+  __s->__num_taps = __num_taps;						\
+  __s->__coeffs = __coeffs;						\
+  __s->__state = __state;						\
+  __builtin_memset (__state, 0,						\
+		    (__num_taps + __block_size - 1) * sizeof (T));	\
+}
+
+__RISCV_DSP_FIR (q7, q7_t)
+__RISCV_DSP_FIR (q15, q15_t)
+__RISCV_DSP_FIR (q31, q31_t)
+
+__extension__ static __inline void
+__riscv_dsp_fir_q7 (const __riscv_dsp_fir_q7_t *__s, const q7_t *__src,
+		    q7_t *__dst, size_t __block_size)
+{
+  const size_t __l = __RISCV_DSP_LANES_q7, __taps = __s->__num_taps;
+  const q7_t *__c = __s->__coeffs;
+  q7_t *__st = __s->__state;
+  size_t __i, __k;
+
+  __builtin_memcpy (__st + __taps - 1, __src, __block_size * sizeof (q7_t));
+  for (__i = 0; __i < __block_size; __i++)
+    {
+      const q7_t *__x = __st + __i;
+      __riscv_dsp_acc_q7xn_t __acc = __riscv_dsp_dup_q31 (0);
+
+      for (__k = 0; __k + __l <= __taps; __k += __l)
+	__acc = __rv__v_smaqa (__acc, __riscv_dsp_load_q7 (__x + __k),
+			       __riscv_dsp_load_q7 (__c + __k));
+      if (__k < __taps)
+	__acc = __rv__v_smaqa (__acc,
+			       __riscv_dsp_load_q7_n (__x + __k, __taps - __k),
+			       __riscv_dsp_load_q7_n (__c + __k, __taps - __k));
+      __dst[__i] = __riscv_dsp_sat_q7 (__riscv_dsp_hsum_acc_q7xn (__acc) >> 7);
+    }
+  __builtin_memmove (__st, __st + __block_size, (__taps - 1) * sizeof (q7_t));
+}
+
+__extension__ static __inline void
+__riscv_dsp_fir_q15 (const __riscv_dsp_fir_q15_t *__s, const q15_t *__src,
+		     q15_t *__dst, size_t __block_size)
+{
+  const size_t __l = __RISCV_DSP_LANES_q15, __taps = __s->__num_taps;
+  const q15_t *__c = __s->__coeffs;
+  q15_t *__st = __s->__state;
+  size_t __i, __k;
+
+  __builtin_memcpy (__st + __taps - 1, __src, __block_size * sizeof (q15_t));
+  for (__i = 0; __i < __block_size; __i++)
+    {
+      const q15_t *__x = __st + __i;
+      q63_t __acc = 0;
+
+      for (__k = 0; __k + __l <= __taps; __k += __l)
+	__acc = __riscv_dsp_mac_q15 (__acc, __riscv_dsp_load_q15 (__x + __k),
+				     __riscv_dsp_load_q15 (__c + __k));
+      if (__k < __taps)
+	__acc = __riscv_dsp_mac_q15 (__acc,
+				     __riscv_dsp_load_q15_n (__x + __k,
+							     __taps - __k),
+				     __riscv_dsp_load_q15_n (__c + __k,
+							     __taps - __k));
+      __dst[__i] = __riscv_dsp_sat_q15 (__acc >> 15);
+    }
+  __builtin_memmove (__st, __st + __block_size,
+		     (__taps - 1) * sizeof (q15_t));
+}
+
+__extension__ static __inline void
+__riscv_dsp_fir_q31 (const __riscv_dsp_fir_q31_t *__s, const q31_t *__src,
+		     q31_t *__dst, size_t __block_size)
+{
+  const size_t __taps = __s->__num_taps;
+  const q31_t *__c = __s->__coeffs;
+  q31_t *__st = __s->__state;
+  size_t __i, __k;
+
+  __builtin_memcpy (__st + __taps - 1, __src, __block_size * sizeof (q31_t));
+  for (__i = 0; __i < __block_size; __i++)
+    {
+      const q31_t *__x = __st + __i;
+      q63_t __acc = 0;
+
+      for (__k = 0; __k < __taps; __k++)
+	__acc = __riscv_dsp_mac_q31 (__acc, __x[__k], __c[__k]);
+      __dst[__i] = __riscv_dsp_sat_q31 (__acc >> 31);
+    }
+  __builtin_memmove (__st, __st + __block_size,
+		     (__taps - 1) * sizeof (q31_t));
+}
+
+/* Cascades of direct form I biquads.  Each stage computes
+     y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2]
+   so the feedback coefficients carry the opposite sign from the usual
+   transfer function.  COEFFS holds {b0, 0, b1, b2, a1, a2} per Q15 stage
+   and {b0, b1, b2, a1, a2} per Q31 stage, STATE holds
+   {x[n-1], x[n-2], y[n-1], y[n-2]} per stage, and POST_SHIFT scales the
+   coefficients up by that power of two.  */
+
+#define __RISCV_DSP_BIQUAD(SFX, T)					\
+typedef struct								\
+{									\
+  unsigned int __num_stages;						\
+  T *__state;								\
+  const T *__coeffs;							\
+  int8_t __post_shift;							\
+} __riscv_dsp_biquad_##SFX##_t;						\
+									\
+__extension__ static __inline void					\
+__riscv_dsp_biquad_init_##SFX (__riscv_dsp_biquad_##SFX##_t *__s,	\
+			       unsigned int __num_stages,		\
+			       const T *__coeffs, T *__state,		\
+			       int8_t __post_shift)			\
+{									\
+  __s->__num_stages = __num_stages;					\
+  __s->__coeffs = __coeffs;						\
+  __s->__state = __state;						\
+  __s->__post_shift = __post_shift;					\
+  __builtin_memset (__state, 0, 4 * __num_stages * sizeof (T));		\
+}
+
+__RISCV_DSP_BIQUAD (q15, q15_t)
+__RISCV_DSP_BIQUAD (q31, q31_t)
+
+/* The x and y history is laid out to match {b1, b2, a1, a2}, so four of
+   the five products are whole-register multiply-adds.  */
+__extension__ static __inline void
+__riscv_dsp_biquad_q15 (const __riscv_dsp_biquad_q15_t *__s,
+			const q15_t *__src, q15_t *__dst, size_t __block_size)
+{
+  const size_t __l = __RISCV_DSP_LANES_q15;
+  const q15_t *__c = __s->__coeffs;
+  q15_t *__st = __s->__state;
+  const int __shift = 15 - __s->__post_shift;
+  unsigned int __stage;
+  size_t __i, __k;
+
+  for (__stage = 0; __stage < __s->__num_stages;
+       __stage++, __c += 6, __st += 4, __src = __dst)
+    for (__i = 0; __i < __block_size; __i++)
+      {
+	q15_t __x = __src[__i], __y;
+	q63_t __acc = (q31_t) __c[0] * __x;
+
+	for (__k = 0; __k < 4; __k += __l)
+	  __acc = __riscv_dsp_mac_q15 (__acc, __riscv_dsp_load_q15 (__st + __k),
+				       __riscv_dsp_load_q15 (__c + 2 + __k));
+	__y = __riscv_dsp_sat_q15 (__acc >> __shift);
+	__st[1] = __st[0];
+	__st[0] = __x;
+	__st[3] = __st[2];
+	__st[2] = __y;
+	__dst[__i] = __y;
+      }
+}
+
+__extension__ static __inline void
+__riscv_dsp_biquad_q31 (const __riscv_dsp_biquad_q31_t *__s,
+			const q31_t *__src, q31_t *__dst, size_t __block_size)
+{
+  const q31_t *__c = __s->__coeffs;
+  q31_t *__st = __s->__state;
+  const int __shift = 31 - __s->__post_shift;
+  unsigned int __stage;
+  size_t __i;
+
+  for (__stage = 0; __stage < __s->__num_stages;
+       __stage++, __c += 5, __st += 4, __src = __dst)
+    for (__i = 0; __i < __block_size; __i++)
+      {
+	q31_t __x = __src[__i], __y;
+	q63_t __acc = __riscv_dsp_mac_q31 (0, __c[0], __x);
+
+	__acc = __riscv_dsp_mac_q31 (__acc, __c[1], __st[0]);
+	__acc = __riscv_dsp_mac_q31 (__acc, __c[2], __st[1]);
+	__acc = __riscv_dsp_mac_q31 (__acc, __c[3], __st[2]);
+	__acc = __riscv_dsp_mac_q31 (__acc, __c[4], __st[3]);
+	__y = __riscv_dsp_sat_q31 (__acc >> __shift);
+	__st[1] = __st[0];
+	__st[0] = __x;
+	__st[3] = __st[2];
+	__st[2] = __y;
+	__dst[__i] = __y;
+      }
+}
+
+/* Row-major matrices.  The functions return __RISCV_DSP_SIZE_MISMATCH
+   without touching DST when the shapes do not agree.  */
+
+#define __RISCV_DSP_MATRIX(SFX, T)					\
+typedef struct								\
+{									\
+  uint16_t __rows;							\
+  uint16_t __cols;							\
+  T *__data;								\
+} __riscv_dsp_matrix_##SFX##_t;						\
+									\
+__extension__ static __inline void					\
+__riscv_dsp_mat_init_##SFX (__riscv_dsp_matrix_##SFX##_t *__m,		\
+			    uint16_t __rows, uint16_t __cols, T *__data) \
+{									\
+  __m->__rows = __rows;							\
+  __m->__cols = __cols;							\
+  __m->__data = __data;							\
+}									\
+									\
+__extension__ static __inline int					\
+__riscv_dsp_mat_add_##SFX (const __riscv_dsp_matrix_##SFX##_t *__a,	\
+			   const __riscv_dsp_matrix_##SFX##_t *__b,	\
+			   __riscv_dsp_matrix_##SFX##_t *__dst)		\
+{									\
+  if (__a->__rows != __b->__rows || __a->__cols != __b->__cols		\
+      || __a->__rows != __dst->__rows || __a->__cols != __dst->__cols)	\
+    return __RISCV_DSP_SIZE_MISMATCH;					\
+  __riscv_dsp_add_##SFX (__a->__data, __b->__data, __dst->__data,	\
+			 (size_t) __a->__rows * __a->__cols);		\
+  return __RISCV_DSP_OK;						\
+}									\
+									\
+__extension__ static __inline int					\
+__riscv_dsp_mat_sub_##SFX (const __riscv_dsp_matrix_##SFX##_t *__a,	\
+			   const __riscv_dsp_matrix_##SFX##_t *__b,	\
+			   __riscv_dsp_matrix_##SFX##_t *__dst)		\
+{									\
+  if (__a->__rows != __b->__rows || __a->__cols != __b->__cols		\
+      || __a->__rows != __dst->__rows || __a->__cols != __dst->__cols)	\
+    return __RISCV_DSP_SIZE_MISMATCH;					\
+  __riscv_dsp_sub_##SFX (__a->__data, __b->__data, __dst->__data,	\
+			 (size_t) __a->__rows * __a->__cols);		\
+  return __RISCV_DSP_OK;						\
+}									\
+									\
+__extension__ static __inline int					\
+__riscv_dsp_mat_trans_##SFX (const __riscv_dsp_matrix_##SFX##_t *__a,	\
+			     __riscv_dsp_matrix_##SFX##_t *__dst)	\
+{									\
+  size_t __i, __j;							\
+									\
+  if (__a->__rows != __dst->__cols || __a->__cols != __dst->__rows)	\
+    return __RISCV_DSP_SIZE_MISMATCH;					\
+  for (__i = 0; __i < __a->__rows; __i++)				\
+    for (__j = 0; __j < __a->__cols; __j++)				\
+      __dst->__data[__j * __a->__rows + __i]				\
+	= __a->__data[__i * __a->__cols + __j];				\
+  return __RISCV_DSP_OK;						\
+}
+
+__RISCV_DSP_MATRIX (q15, q15_t)
+__RISCV_DSP_MATRIX (q31, q31_t)
+
+/* DST = A B, each element the saturated 34.30 sum.  SCRATCH must hold
+   B->rows * B->cols elements; B is transposed into it first so that
+   the inner products run over contiguous registers.  */
+__extension__ static __inline int
+__riscv_dsp_mat_mult_q15 (const __riscv_dsp_matrix_q15_t *__a,
+			  const __riscv_dsp_matrix_q15_t *__b,
+			  __riscv_dsp_matrix_q15_t *__dst, q15_t *__scratch)
+{
+  const size_t __n = __a->__cols;
+  __riscv_dsp_matrix_q15_t __bt;
+  size_t __i, __j;
+
+  if (__a->__cols != __b->__rows || __a->__rows != __dst->__rows
+      || __b->__cols != __dst->__cols)
+    return __RISCV_DSP_SIZE_MISMATCH;
+  __riscv_dsp_mat_init_q15 (&__bt, __b->__cols, __b->__rows, __scratch);
+  __riscv_dsp_mat_trans_q15 (__b, &__bt);
+  for (__i = 0; __i < __a->__rows; __i++)
+    for (__j = 0; __j < __b->__cols; __j++)
+      {
+	q63_t __acc = __riscv_dsp_dot_prod_q15 (__a->__data + __i * __n,
+						__scratch + __j * __n, __n);
+
+	__dst->__data[__i * __b->__cols + __j]
+	  = __riscv_dsp_sat_q15 (__acc >> 15);
+      }
+  return __RISCV_DSP_OK;
+}
+
+/* DST = A B, each element the saturated 2.62 sum.  */
+__extension__ static __inline int
+__riscv_dsp_mat_mult_q31 (const __riscv_dsp_matrix_q31_t *__a,
+			  const __riscv_dsp_matrix_q31_t *__b,
+			  __riscv_dsp_matrix_q31_t *__dst)
+{
+  const size_t __n = __a->__cols, __m = __b->__cols;
+  size_t __i, __j, __k;
+
+  if (__a->__cols != __b->__rows || __a->__rows != __dst->__rows
+      || __b->__cols != __dst->__cols)
+    return __RISCV_DSP_SIZE_MISMATCH;
+  for (__i = 0; __i < __a->__rows; __i++)
+    for (__j = 0; __j < __m; __j++)
+      {
+	q63_t __acc = 0;
+
+	for (__k = 0; __k < __n; __k++)
+	  __acc = __riscv_dsp_mac_q31 (__acc, __a->__data[__i * __n + __k],
+				       __b->__data[__k * __m + __j]);
+	__dst->__data[__i * __m + __j] = __riscv_dsp_sat_q31 (__acc >> 31);
+      }
+  return __RISCV_DSP_OK;
+}
+
+/* Complex Q15 data is interleaved {re, im}, so each 32-bit word holds one
+   sample with the real part in the low halfword, and the packed 16-bit
+   instructions work on XLEN / 32 samples at once.  A product Y W forms
+   Y.re W.re - Y.im W.im with smdrs and Y.re W.im + Y.im W.re with kmxda
+   (kmda and smxds for Y conj (W)), each in Q30; doubling with saturation
+   and packing the top halfwords gives the Q15 result.  */
+
+#define __RISCV_DSP_LANES_cq15	(__riscv_xlen / 32)
+
+__extension__ static __inline uintXLEN_t
+__riscv_dsp_load_cq15_n (const q15_t *__p, size_t __n)
+{
+  uintXLEN_t __v = 0;
+
+  __builtin_memcpy (&__v, __p, __n * 2 * sizeof (q15_t));
+  return __v;
+}
+
+__extension__ static __inline void
+__riscv_dsp_store_cq15_n (q15_t *__p, uintXLEN_t __v, size_t __n)
+{
+  __builtin_memcpy (__p, &__v, __n * 2 * sizeof (q15_t));
+}
+
+__extension__ static __inline uintXLEN_t
+__riscv_dsp_kdouble_32 (intXLEN_t __x)
+{
+#if __riscv_xlen == 64
+  return __rv__ksll32 ((uint64_t) __x, 1);
+#else
+  return (uint32_t) __rv__ksllw (__x, 1);
+#endif
+}
+
+__extension__ static __inline uintXLEN_t
+__riscv_dsp_cmul_cq15xn (uintXLEN_t __y, uintXLEN_t __w)
+{
+  return __rv__pktt16 (__riscv_dsp_kdouble_32 (__rv__kmxda (__y, __w)),
+		       __riscv_dsp_kdouble_32 (__rv__smdrs (__y, __w)));
+}
+
+__extension__ static __inline uintXLEN_t
+__riscv_dsp_cmulc_cq15xn (uintXLEN_t __y, uintXLEN_t __w)
+{
+  return __rv__pktt16 (__riscv_dsp_kdouble_32 (__rv__smxds (__y, __w)),
+		       __riscv_dsp_kdouble_32 (__rv__kmda (__y, __w)));
+}
+
+/* DST[i] = sat (A[i] B[i]) for N complex samples.  */
+__extension__ static __inline void
+__riscv_dsp_cmplx_mult_cmplx_q15 (const q15_t *__a, const q15_t *__b,
+				  q15_t *__dst, size_t __n)
+{
+  const size_t __l = __RISCV_DSP_LANES_cq15;
+
+  for (; __n > 0; __n -= __l < __n ? __l : __n)
+    {
+      const size_t __k = __l < __n ? __l : __n;
+
+      __riscv_dsp_store_cq15_n (__dst,
+				__riscv_dsp_cmul_cq15xn
+				  (__riscv_dsp_load_cq15_n (__a, __k),
+				   __riscv_dsp_load_cq15_n (__b, __k)),
+				__k);
+      __a += 2 * __k;
+      __b += 2 * __k;
+      __dst += 2 * __k;
+    }
+}
+
+/* *RE + j *IM = sum (A[i] B[i]) over N complex samples, in 34.30.  With
+   Zpsfoperand, smaldrs and smalxda accumulate the real and imaginary
+   parts straight into 64 bits.  */
+__extension__ static __inline void
+__riscv_dsp_cmplx_dot_prod_q15 (const q15_t *__a, const q15_t *__b,
+				size_t __n, q63_t *__re, q63_t *__im)
+{
+  const size_t __l = __RISCV_DSP_LANES_cq15;
+  q63_t __r = 0, __i = 0;
+
+  for (; __n > 0; __n -= __l < __n ? __l : __n)
+    {
+      const size_t __k = __l < __n ? __l : __n;
+      uintXLEN_t __x = __riscv_dsp_load_cq15_n (__a, __k);
+      uintXLEN_t __y = __riscv_dsp_load_cq15_n (__b, __k);
+#if __riscv_zpsfoperand
+      __r = __rv__smaldrs (__r, __x, __y);
+      __i = __rv__smalxda (__i, __x, __y);
+#else
+      intXLEN_t __pr = __rv__smdrs (__x, __y), __pi = __rv__kmxda (__x, __y);
+
+      __r += (int32_t) __pr;
+      __i += (int32_t) __pi;
+#if __riscv_xlen == 64
+      __r += (int32_t) (__pr >> 32);
+      __i += (int32_t) (__pi >> 32);
+#endif
+#endif
+      __a += 2 * __k;
+      __b += 2 * __k;
+    }
+  *__re = __r;
+  *__im = __i;
+}
+
+/* Bit reversal of the low BITS bits of I, BITS <= 16.  */
+__extension__ static __inline size_t
+__riscv_dsp_bitrev (size_t __i, unsigned int __bits)
+{
+  static const uint8_t __rev8[256] = {
+    0x00, 0x80, 0x40, 0xc0, 0x20, 0xa0, 0x60, 0xe0, 0x10, 0x90, 0x50, 0xd0,
+    0x30, 0xb0, 0x70, 0xf0, 0x08, 0x88, 0x48, 0xc8, 0x28, 0xa8, 0x68, 0xe8,
+    0x18, 0x98, 0x58, 0xd8, 0x38, 0xb8, 0x78, 0xf8, 0x04, 0x84, 0x44, 0xc4,
+    0x24, 0xa4, 0x64, 0xe4, 0x14, 0x94, 0x54, 0xd4, 0x34, 0xb4, 0x74, 0xf4,
+    0x0c, 0x8c, 0x4c, 0xcc, 0x2c, 0xac, 0x6c, 0xec, 0x1c, 0x9c, 0x5c, 0xdc,
+    0x3c, 0xbc, 0x7c, 0xfc, 0x02, 0x82, 0x42, 0xc2, 0x22, 0xa2, 0x62, 0xe2,
+    0x12, 0x92, 0x52, 0xd2, 0x32, 0xb2, 0x72, 0xf2, 0x0a, 0x8a, 0x4a, 0xca,
+    0x2a, 0xaa, 0x6a, 0xea, 0x1a, 0x9a, 0x5a, 0xda, 0x3a, 0xba, 0x7a, 0xfa,
+    0x06, 0x86, 0x46, 0xc6, 0x26, 0xa6, 0x66, 0xe6, 0x16, 0x96, 0x56, 0xd6,
+    0x36, 0xb6, 0x76, 0xf6, 0x0e, 0x8e, 0x4e, 0xce, 0x2e, 0xae, 0x6e, 0xee,
+    0x1e, 0x9e, 0x5e, 0xde, 0x3e, 0xbe, 0x7e, 0xfe, 0x01, 0x81, 0x41, 0xc1,
+    0x21, 0xa1, 0x61, 0xe1, 0x11, 0x91, 0x51, 0xd1, 0x31, 0xb1, 0x71, 0xf1,
+    0x09, 0x89, 0x49, 0xc9, 0x29, 0xa9, 0x69, 0xe9, 0x19, 0x99, 0x59, 0xd9,
+    0x39, 0xb9, 0x79, 0xf9, 0x05, 0x85, 0x45, 0xc5, 0x25, 0xa5, 0x65, 0xe5,
+    0x15, 0x95, 0x55, 0xd5, 0x35, 0xb5, 0x75, 0xf5, 0x0d, 0x8d, 0x4d, 0xcd,
+    0x2d, 0xad, 0x6d, 0xed, 0x1d, 0x9d, 0x5d, 0xdd, 0x3d, 0xbd, 0x7d, 0xfd,
+    0x03, 0x83, 0x43, 0xc3, 0x23, 0xa3, 0x63, 0xe3, 0x13, 0x93, 0x53, 0xd3,
+    0x33, 0xb3, 0x73, 0xf3, 0x0b, 0x8b, 0x4b, 0xcb, 0x2b, 0xab, 0x6b, 0xeb,
+    0x1b, 0x9b, 0x5b, 0xdb, 0x3b, 0xbb, 0x7b, 0xfb, 0x07, 0x87, 0x47, 0xc7,
+    0x27, 0xa7, 0x67, 0xe7, 0x17, 0x97, 0x57, 0xd7, 0x37, 0xb7, 0x77, 0xf7,
+    0x0f, 0x8f, 0x4f, 0xcf, 0x2f, 0xaf, 0x6f, 0xef, 0x1f, 0x9f, 0x5f, 0xdf,
+    0x3f, 0xbf, 0x7f, 0xff
+  };
+
+  return (size_t) (__rev8[__i & 0xff] << 8 | __rev8[(__i >> 8) & 0xff])
+	 >> (16 - __bits);
+}
+
+__extension__ static __inline unsigned int
+__riscv_dsp_log2 (size_t __n)
+{
+  unsigned int __b = 0;
+
+  while (((size_t) 1 << __b) < __n)
+    __b++;
+  return __b;
+}
+
+/* Permute N complex samples into bit-reversed order.  */
+__extension__ static __inline void
+__riscv_dsp_bitrev_q15 (q15_t *__buf, size_t __n)
+{
+  const unsigned int __bits = __riscv_dsp_log2 (__n);
+  size_t __i, __j;
+  uint32_t __t, __u;
+
+  for (__i = 1; __i < __n - 1; __i++)
+    if ((__j = __riscv_dsp_bitrev (__i, __bits)) > __i)
+      {
+	__builtin_memcpy (&__t, __buf + 2 * __i, sizeof (__t));
+	__builtin_memcpy (&__u, __buf + 2 * __j, sizeof (__u));
+	__builtin_memcpy (__buf + 2 * __i, &__u, sizeof (__u));
+	__builtin_memcpy (__buf + 2 * __j, &__t, sizeof (__t));
+      }
+}
+
+__extension__ static __inline void
+__riscv_dsp_bitrev_q31 (q31_t *__buf, size_t __n)
+{
+  const unsigned int __bits = __riscv_dsp_log2 (__n);
+  size_t __i, __j;
+  q31_t __re, __im;
+
+  for (__i = 1; __i < __n - 1; __i++)
+    if ((__j = __riscv_dsp_bitrev (__i, __bits)) > __i)
+      {
+	__re = __buf[2 * __i];
+	__im = __buf[2 * __i + 1];
+	__buf[2 * __i] = __buf[2 * __j];
+	__buf[2 * __i + 1] = __buf[2 * __j + 1];
+	__buf[2 * __j] = __re;
+	__buf[2 * __j + 1] = __im;
+      }
+}
+
+#define __RISCV_DSP_FFT_MAX	4096
+
+/* *COS and *SIN of 2 pi K / N in Q31, for N a power of two no larger
+   than __RISCV_DSP_FFT_MAX and K < N.  The angle is split into a quadrant,
+   a multiple of 2 pi / 128 and a multiple of 2 pi / 4096, and the last two
+   are combined by the angle-sum identities; the result is within 2 ulp.  */
+__extension__ static __inline void
+__riscv_dsp_sincos_q31 (size_t __k, size_t __n, q31_t *__cos, q31_t *__sin)
+{
+  /* cos (2 pi I / 128), I = 0 .. 32.  */
+  static const q31_t __coarse[33] = {
+    2147483647, 2144896910, 2137142927, 2124240380, 2106220352, 2083126254,
+    2055013723, 2021950484, 1984016189, 1941302225, 1893911494, 1841958164,
+    1785567396, 1724875040, 1660027308, 1591180426, 1518500250, 1442161874,
+    1362349204, 1279254516, 1193077991, 1104027237, 1012316784, 918167572,
+    821806413, 723465451, 623381598, 521795963, 418953276, 315101295,
+    210490206, 105372028, 0
+  };
+  /* cos and sin (2 pi I / 4096), I = 0 .. 31.  */
+  static const q31_t __fine_cos[32] = {
+    2147483647, 2147481121, 2147473542, 2147460908, 2147443222, 2147420483,
+    2147392690, 2147359845, 2147321946, 2147278995, 2147230991, 2147177934,
+    2147119825, 2147056664, 2146988450, 2146915184, 2146836866, 2146753497,
+    2146665076, 2146571603, 2146473080, 2146369505, 2146260881, 2146147205,
+    2146028480, 2145904705, 2145775880, 2145642006, 2145503083, 2145359112,
+    2145210092, 2145056025
+  };
+  static const q31_t __fine_sin[32] = {
+    0, 3294197, 6588387, 9882561, 13176712, 16470832, 19764913, 23058947,
+    26352928, 29646846, 32940695, 36234466, 39528151, 42821744, 46115236,
+    49408620, 52701887, 55995030, 59288042, 62580914, 65873638, 69166208,
+    72458615, 75750851, 79042909, 82334782, 85626460, 88917937, 92209205,
+    95500255, 98791081, 102081675
+  };
+  const size_t __t = __k * (__RISCV_DSP_FFT_MAX / __n);
+  const size_t __r = __t & 1023, __c = __r >> 5, __f = __r & 31;
+  const q63_t __ca = __coarse[__c], __sa = __coarse[32 - __c];
+  const q63_t __cb = __fine_cos[__f], __sb = __fine_sin[__f];
+  q31_t __x, __y;
+
+  __x = __riscv_dsp_sat_q31 ((__ca * __cb - __sa * __sb + (1LL << 30)) >> 31);
+  __y = __riscv_dsp_sat_q31 ((__sa * __cb + __ca * __sb + (1LL << 30)) >> 31);
+  switch (__t >> 10)
+    {
+    case 0:
+      *__cos = __x;
+      *__sin = __y;
+      break;
+    case 1:
+      *__cos = -__y;
+      *__sin = __x;
+      break;
+    case 2:
+      *__cos = -__x;
+      *__sin = -__y;
+      break;
+    default:
+      *__cos = __y;
+      *__sin = -__x;
+      break;
+    }
+}
+
+/* Complex FFTs of N = 2^k points, 4 <= N <= __RISCV_DSP_FFT_MAX, in place
+   on interleaved {re, im} data.  The transform is decimation in
+   frequency: radix-4 passes, preceded by one radix-2 pass when k is odd,
+   leave the spectrum in bit-reversed order, which BITREV then undoes.
+   Every pass halves (radix-2) or quarters (radix-4) the data, so both the
+   forward and the inverse transform return the result divided by N.
+
+   Each input point must have a magnitude |re + j im| of at most 1.  The
+   scaling keeps the sums in range, but a twiddle rotation of a larger
+   point can exceed full scale on one axis and saturate: with re = im
+   = 0.915, some odd bins come out about 0.08 off.  Scale data that may
+   reach full scale on both axes by 1/sqrt 2 first.
+
+   The init functions fill TWIDDLE, which must hold 3 N / 2 values, with
+   W^i = exp (-2 pi j i / N) for i < 3 N / 4, and return
+   __RISCV_DSP_SIZE_MISMATCH for an unsupported N.  */
+
+#define __RISCV_DSP_CFFT(SFX, T)					\
+typedef struct								\
+{									\
+  uint16_t __fft_len;							\
+  const T *__twiddle;							\
+} __riscv_dsp_cfft_##SFX##_t;						\
+									\
+__extension__ static __inline int					\
+__riscv_dsp_cfft_init_##SFX (__riscv_dsp_cfft_##SFX##_t *__s,		\
+			     uint16_t __n, T *__twiddle)		\
+{									\
+  size_t __i;								\
+									\
+  if (__n < 4 || __n > __RISCV_DSP_FFT_MAX || (__n & (__n - 1)) != 0)	\
+    return __RISCV_DSP_SIZE_MISMATCH;					\
+  for (__i = 0; __i < 3 * (size_t) __n / 4; __i++)			\
+    {									\
+      q31_t __cos, __sin;						\
+									\
+      __riscv_dsp_sincos_q31 (__i, __n, &__cos, &__sin);		\
+      __twiddle[2 * __i] = __riscv_dsp_twiddle_##SFX (__cos);		\
+      __twiddle[2 * __i + 1] = __riscv_dsp_twiddle_##SFX (-__sin);	\
+    }									\
+  __s->__fft_len = __n;							\
+  __s->__twiddle = __twiddle;						\
+  return __RISCV_DSP_OK;						\
+}
+
+__extension__ static __inline q15_t
+__riscv_dsp_twiddle_q15 (q31_t __x)
+{
+  return __riscv_dsp_sat_q15 (((q63_t) __x + (1 << 15)) >> 16);
+}
+
+__extension__ static __inline q31_t
+__riscv_dsp_twiddle_q31 (q31_t __x)
+{
+  return __x;
+}
+
+__RISCV_DSP_CFFT (q15, q15_t)
+__RISCV_DSP_CFFT (q31, q31_t)
+
+/* Twiddles W^K and W^(K + STEP) side by side, as many as fit a word.  */
+__extension__ static __inline uintXLEN_t
+__riscv_dsp_load_tw_q15 (const q15_t *__tw, size_t __k, size_t __step,
+			 size_t __lanes)
+{
+  uintXLEN_t __w = __riscv_dsp_load_cq15_n (__tw + 2 * __k, 1);
+
+#if __riscv_xlen == 64
+  if (__lanes > 1)
+    __w |= __riscv_dsp_load_cq15_n (__tw + 2 * (__k + __step), 1) << 32;
+#else
+  (void) __step;
+  (void) __lanes;
+#endif
+  return __w;
+}
+
+__extension__ static __inline void
+__riscv_dsp_cfft_q15 (const __riscv_dsp_cfft_q15_t *__s, q15_t *__buf,
+		      int __inverse, int __bitrev)
+{
+  const size_t __n = __s->__fft_len;
+  const q15_t *__tw = __s->__twiddle;
+  uintXLEN_t (*const __cmul) (uintXLEN_t, uintXLEN_t)
+    = __inverse ? __riscv_dsp_cmulc_cq15xn : __riscv_dsp_cmul_cq15xn;
+  size_t __m = __n, __base, __i;
+
+  if (__riscv_dsp_log2 (__n) & 1)
+    {
+      const size_t __h = __n / 2;
+      const size_t __l = __RISCV_DSP_LANES_cq15;
+
+      for (__i = 0; __i < __h; __i += __l)
+	{
+	  q15_t *__p = __buf + 2 * __i;
+	  uintXLEN_t __a = __riscv_dsp_load_cq15_n (__p, __l);
+	  uintXLEN_t __b = __riscv_dsp_load_cq15_n (__p + 2 * __h, __l);
+
+	  __riscv_dsp_store_cq15_n (__p, __rv__radd16 (__a, __b), __l);
+	  __riscv_dsp_store_cq15_n (__p + 2 * __h,
+				    __cmul (__rv__rsub16 (__a, __b),
+					    __riscv_dsp_load_tw_q15 (__tw, __i,
+								     1, __l)),
+				    __l);
+	}
+      __m = __h;
+    }
+
+  for (; __m >= 4; __m /= 4)
+    {
+      const size_t __q = __m / 4, __st = __n / __m;
+      const size_t __l
+	= __q < __RISCV_DSP_LANES_cq15 ? 1 : __RISCV_DSP_LANES_cq15;
+
+      for (__base = 0; __base < __n; __base += __m)
+	for (__i = 0; __i < __q; __i += __l)
+	  {
+	    q15_t *__p = __buf + 2 * (__base + __i);
+	    uintXLEN_t __x0 = __riscv_dsp_load_cq15_n (__p, __l);
+	    uintXLEN_t __x1 = __riscv_dsp_load_cq15_n (__p + 2 * __q, __l);
+	    uintXLEN_t __x2 = __riscv_dsp_load_cq15_n (__p + 4 * __q, __l);
+	    uintXLEN_t __x3 = __riscv_dsp_load_cq15_n (__p + 6 * __q, __l);
+	    uintXLEN_t __s0 = __rv__radd16 (__x0, __x2);
+	    uintXLEN_t __d0 = __rv__rsub16 (__x0, __x2);
+	    uintXLEN_t __s1 = __rv__radd16 (__x1, __x3);
+	    uintXLEN_t __d1 = __rv__rsub16 (__x1, __x3);
+	    uintXLEN_t __y0 = __rv__radd16 (__s0, __s1);
+	    uintXLEN_t __y2 = __rv__rsub16 (__s0, __s1);
+	    /* D0 -/+ j D1 by a halving cross add/subtract.  */
+	    uintXLEN_t __y1 = __inverse ? __rv__rcras16 (__d0, __d1)
+				       : __rv__rcrsa16 (__d0, __d1);
+	    uintXLEN_t __y3 = __inverse ? __rv__rcrsa16 (__d0, __d1)
+				       : __rv__rcras16 (__d0, __d1);
+
+	    if (__q > 1)
+	      {
+		__y2 = __cmul (__y2, __riscv_dsp_load_tw_q15 (__tw,
+							      2 * __i * __st,
+							      2 * __st, __l));
+		__y1 = __cmul (__y1, __riscv_dsp_load_tw_q15 (__tw,
+							      __i * __st,
+							      __st, __l));
+		__y3 = __cmul (__y3, __riscv_dsp_load_tw_q15 (__tw,
+							      3 * __i * __st,
+							      3 * __st, __l));
+	      }
+	    /* Storing Y2 before Y1 keeps the output in bit-reversed
+	       rather than digit-reversed order.  */
+	    __riscv_dsp_store_cq15_n (__p, __y0, __l);
+	    __riscv_dsp_store_cq15_n (__p + 2 * __q, __y2, __l);
+	    __riscv_dsp_store_cq15_n (__p + 4 * __q, __y1, __l);
+	    __riscv_dsp_store_cq15_n (__p + 6 * __q, __y3, __l);
+	  }
+    }
+
+  if (__bitrev)
+    __riscv_dsp_bitrev_q15 (__buf, __n);
+}
+
+/* Y W or Y conj (W) for Q31 complex values, saturated.  */
+__extension__ static __inline void
+__riscv_dsp_cmul_q31 (q31_t *__y, const q31_t *__w, int __conj)
+{
+  const q31_t __wi = __conj ? -__w[1] : __w[1];
+  q63_t __re = __riscv_dsp_mac_q31 (__riscv_dsp_mac_q31 (0, __y[0], __w[0]),
+				     __y[1], -__wi);
+  q63_t __im = __riscv_dsp_mac_q31 (__riscv_dsp_mac_q31 (0, __y[0], __wi),
+				     __y[1], __w[0]);
+
+  __y[0] = __riscv_dsp_sat_q31 (__re >> 31);
+  __y[1] = __riscv_dsp_sat_q31 (__im >> 31);
+}
+
+/* The Q31 passes keep full 64-bit products; halving sums are formed in
+   64 bits, so nothing saturates before the twiddle multiply.  */
+__extension__ static __inline void
+__riscv_dsp_cfft_q31 (const __riscv_dsp_cfft_q31_t *__s, q31_t *__buf,
+		      int __inverse, int __bitrev)
+{
+  const size_t __n = __s->__fft_len;
+  const q31_t *__tw = __s->__twiddle;
+  size_t __m = __n, __base, __i;
+  int __j;
+
+  if (__riscv_dsp_log2 (__n) & 1)
+    {
+      const size_t __h = __n / 2;
+
+      for (__i = 0; __i < __h; __i++)
+	{
+	  q31_t *__p = __buf + 2 * __i, *__r = __p + 2 * __h;
+
+	  for (__j = 0; __j < 2; __j++)
+	    {
+	      q63_t __a = __p[__j], __b = __r[__j];
+
+	      __p[__j] = (q31_t) ((__a + __b) >> 1);
+	      __r[__j] = (q31_t) ((__a - __b) >> 1);
+	    }
+	  __riscv_dsp_cmul_q31 (__r, __tw + 2 * __i, __inverse);
+	}
+      __m = __h;
+    }
+
+  for (; __m >= 4; __m /= 4)
+    {
+      const size_t __q = __m / 4, __st = __n / __m;
+
+      for (__base = 0; __base < __n; __base += __m)
+	for (__i = 0; __i < __q; __i++)
+	  {
+	    q31_t *__p = __buf + 2 * (__base + __i);
+	    q63_t __s0[2], __d0[2], __s1[2], __d1[2];
+
+	    for (__j = 0; __j < 2; __j++)
+	      {
+		__s0[__j] = (q63_t) __p[__j] + __p[4 * __q + __j];
+		__d0[__j] = (q63_t) __p[__j] - __p[4 * __q + __j];
+		__s1[__j] = (q63_t) __p[2 * __q + __j] + __p[6 * __q + __j];
+		__d1[__j] = (q63_t) __p[2 * __q + __j] - __p[6 * __q + __j];
+	      }
+	    for (__j = 0; __j < 2; __j++)
+	      {
+		__p[__j] = (q31_t) ((__s0[__j] + __s1[__j]) >> 2);
+		__p[2 * __q + __j] = (q31_t) ((__s0[__j] - __s1[__j]) >> 2);
+	      }
+	    /* D0 -/+ j D1 into the second and fourth quarters.  */
+	    __p[4 * __q] = (q31_t) ((__inverse ? __d0[0] - __d1[1]
+				      : __d0[0] + __d1[1]) >> 2);
+	    __p[4 * __q + 1] = (q31_t) ((__inverse ? __d0[1] + __d1[0]
+					  : __d0[1] - __d1[0]) >> 2);
+	    __p[6 * __q] = (q31_t) ((__inverse ? __d0[0] + __d1[1]
+				      : __d0[0] - __d1[1]) >> 2);
+	    __p[6 * __q + 1] = (q31_t) ((__inverse ? __d0[1] - __d1[0]
+					  : __d0[1] + __d1[0]) >> 2);
+	    if (__q > 1)
+	      {
+		__riscv_dsp_cmul_q31 (__p + 2 * __q, __tw + 4 * __i * __st,
+				      __inverse);
+		__riscv_dsp_cmul_q31 (__p + 4 * __q, __tw + 2 * __i * __st,
+				      __inverse);
+		__riscv_dsp_cmul_q31 (__p + 6 * __q, __tw + 6 * __i * __st,
+				      __inverse);
+	      }
+	  }
+    }
+
+  if (__bitrev)
+    __riscv_dsp_bitrev_q31 (__buf, __n);
+}
+
+/* The cycle counter, for timing the kernels above.  */
+__extension__ static __inline uint64_t
+__riscv_dsp_cycles (void)
+{
+#if __riscv_xlen == 32
+  uint32_t __hi, __lo, __hi2;
+
+  do
+    {
+      __asm__ __volatile__ ("rdcycleh\t%0" : "=r" (__hi));
+      __asm__ __volatile__ ("rdcycle\t%0" : "=r" (__lo));
+      __asm__ __volatile__ ("rdcycleh\t%0" : "=r" (__hi2));
+    }
+  while (__hi != __hi2);
+  return ((uint64_t) __hi << 32) | __lo;
+#else
+  uint64_t __c;
+
+  __asm__ __volatile__ ("rdcycle\t%0" : "=r" (__c));
+  return __c;
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _GCC_RISCV_DSP_MATH_H */
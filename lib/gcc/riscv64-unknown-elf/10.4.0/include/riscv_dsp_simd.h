@@ -0,0 +1,736 @@
+/* RISC-V packed-SIMD value types include file.
+
+   Copyright (C) 2023 Free Software Foundation, Inc.
+
+   This file is part of GCC.
+
+   GCC is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published
+   by the Free Software Foundation; either version 3, or (at your
+   option) any later version.
+
+   GCC is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+   or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+   License for more details.
+
+   Under Section 7 of GPL version 3, you are granted additional
+   permissions described in the GCC Runtime Library Exception, version
+   3.1, as published by the Free Software Foundation.
+
+   You should have received a copy of the GNU General Public License and
+   a copy of the GCC Runtime Library Exception along with this program;
+   see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+   <http://www.gnu.org/licenses/>.  */
+
+#ifndef _GCC_RISCV_DSP_SIMD_H
+#define _GCC_RISCV_DSP_SIMD_H 1
+
+/* C++ value types over one XLEN register of Q15 or Q7 lanes:
+   riscv_dsp::q15x2 and q7x4 on RV32, q15x4 and q7x8 on RV64, with
+   q15xn and q7xn naming whichever is native.  The plain types wrap on
+   overflow; the sat_ variants saturate.  Every operator is a single
+   intrinsic of <riscv-dsp.h>:
+
+     q15xn / q7xn	+ add16/add8, - sub16/sub8, << sll16/sll8,
+			>> sra16/sra8
+     sat_q15xn / sat_q7xn  + kadd16/kadd8, - ksub16/ksub8,
+			* khm16/khm8, << ksll16/ksll8, >> sra16/sra8,
+			abs kabs16/kabs8, shift kslra16/kslra8
+
+   and both kinds compare with scmpeq/scmplt/scmple into a lane mask of
+   the wrapping type, and have min and max through smin/smax.  Unary
+   minus subtracts from zero, so -(-32768) is -32768 for q15xn and 32767
+   for sat_q15xn.
+
+   The operators and element-wise functions are constexpr: during
+   constant evaluation they compute lane by lane with the same
+   semantics, and at run time they call the intrinsic.  dot and dot_acc
+   (kmda/kmada for Q15, smaqa for Q7) reduce into the native
+   accumulator, int32_t on RV32 and int32x2_t on RV64, and are run-time
+   only.  */
+
+#ifndef __cplusplus
+#error "riscv_dsp_simd.h requires C++"
+#endif
+
+#include <riscv-dsp.h>
+
+#if __cplusplus >= 201402L
+#define __RISCV_DSP_CXX14_CONSTEXPR constexpr
+#else
+#define __RISCV_DSP_CXX14_CONSTEXPR
+#endif
+
+#define __RISCV_DSP_SIMD_INLINE __inline __attribute__ ((__always_inline__))
+
+namespace riscv_dsp
+{
+namespace __detail
+{
+  template<typename _Elt, int _N>
+    struct __vec
+    {
+      typedef _Elt __type
+	__attribute__ ((__vector_size__ (sizeof (_Elt) * _N)));
+    };
+
+  template<int... _Idx>
+    struct __index { };
+
+  template<int _N, int... _Idx>
+    struct __make_index : __make_index<_N - 1, _N - 1, _Idx...> { };
+
+  template<int... _Idx>
+    struct __make_index<0, _Idx...>
+    { typedef __index<_Idx...> __type; };
+
+  template<typename _Vec, typename _Fn, int... _Idx>
+    constexpr _Vec
+    __map (_Fn __f, _Vec __a, _Vec __b, __index<_Idx...>)
+    { return _Vec{ __f (__a[_Idx], __b[_Idx])... }; }
+
+  template<typename _Vec, typename _Elt, int... _Idx>
+    constexpr _Vec
+    __splat (_Elt __x, __index<_Idx...>)
+    { return _Vec{ ((void) _Idx, __x)... }; }
+
+  template<typename _Elt>
+    constexpr long long
+    __lane_max ()
+    { return (1ll << (sizeof (_Elt) * 8 - 1)) - 1; }
+
+  template<typename _Elt>
+    constexpr _Elt
+    __sat (long long __x)
+    {
+      return (__x > __lane_max<_Elt> () ? __lane_max<_Elt> ()
+	      : __x < -__lane_max<_Elt> () - 1 ? -__lane_max<_Elt> () - 1
+	      : __x);
+    }
+
+  /* Lane operations for constant evaluation.  Shift counts are taken
+     modulo the lane width as the instructions do; kslra takes the
+     low log2 (width) + 1 bits as a signed count and clamps a right
+     shift of the full width to width - 1.  */
+
+  struct __wrap_add
+  {
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt __b) const
+      { return _Elt (__a + __b); }
+  };
+
+  struct __wrap_sub
+  {
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt __b) const
+      { return _Elt (__a - __b); }
+  };
+
+  struct __sat_add
+  {
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt __b) const
+      { return __sat<_Elt> ((long long) __a + __b); }
+  };
+
+  struct __sat_sub
+  {
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt __b) const
+      { return __sat<_Elt> ((long long) __a - __b); }
+  };
+
+  struct __sat_mulh
+  {
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt __b) const
+      {
+	return __sat<_Elt> (((long long) __a * __b)
+			    >> (sizeof (_Elt) * 8 - 1));
+      }
+  };
+
+  struct __sat_abs
+  {
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt) const
+      { return __sat<_Elt> (__a < 0 ? -(long long) __a : __a); }
+  };
+
+  struct __min
+  {
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt __b) const
+      { return __b < __a ? __b : __a; }
+  };
+
+  struct __max
+  {
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt __b) const
+      { return __a < __b ? __b : __a; }
+  };
+
+  struct __cmpeq
+  {
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt __b) const
+      { return __a == __b ? -1 : 0; }
+  };
+
+  struct __cmplt
+  {
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt __b) const
+      { return __a < __b ? -1 : 0; }
+  };
+
+  struct __cmple
+  {
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt __b) const
+      { return __a <= __b ? -1 : 0; }
+  };
+
+  struct __wrap_shl
+  {
+    unsigned _M_n;
+
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt) const
+      {
+	return _Elt ((long long) __a
+		     * (1ll << (_M_n & (sizeof (_Elt) * 8 - 1))));
+      }
+  };
+
+  struct __sat_shl
+  {
+    unsigned _M_n;
+
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt) const
+      {
+	return __sat<_Elt> ((long long) __a
+			    * (1ll << (_M_n & (sizeof (_Elt) * 8 - 1))));
+      }
+  };
+
+  struct __shr
+  {
+    unsigned _M_n;
+
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt) const
+      { return _Elt (__a >> (_M_n & (sizeof (_Elt) * 8 - 1))); }
+  };
+
+  struct __sat_shift
+  {
+    int _M_n;
+
+    /* Sign-extend the count field of a W-bit lane: log2 (W) + 1
+       bits.  */
+    template<typename _Elt>
+      constexpr int
+      __count () const
+      {
+	return ((int) ((unsigned) _M_n
+		       << (sizeof (_Elt) == 1 ? 28 : 27))
+		>> (sizeof (_Elt) == 1 ? 28 : 27));
+      }
+
+    template<typename _Elt>
+      constexpr _Elt
+      operator() (_Elt __a, _Elt) const
+      {
+	return (__count<_Elt> () >= 0
+		? __sat<_Elt> ((long long) __a * (1ll << __count<_Elt> ()))
+		: _Elt (__a >> (-__count<_Elt> () == int (sizeof (_Elt) * 8)
+				? sizeof (_Elt) * 8 - 1
+				: -__count<_Elt> ())));
+      }
+  };
+
+  /* Run-time lane operations, one intrinsic each.  The wrapping add,
+     sub and sll are defined on the unsigned vector types only.  */
+
+#define __RISCV_DSP_SIMD_OPS(V, U, W)					\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __add (V __a, V __b)							\
+  { return (V) __rv__v_uadd##W ((U) __a, (U) __b); }			\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __sub (V __a, V __b)							\
+  { return (V) __rv__v_usub##W ((U) __a, (U) __b); }			\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __sll (V __a, unsigned __n)						\
+  { return (V) __rv__v_sll##W ((U) __a, __n); }				\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __sra (V __a, unsigned __n)						\
+  { return __rv__v_sra##W (__a, __n); }					\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __kadd (V __a, V __b)							\
+  { return __rv__v_kadd##W (__a, __b); }				\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __ksub (V __a, V __b)							\
+  { return __rv__v_ksub##W (__a, __b); }				\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __khm (V __a, V __b)							\
+  { return __rv__v_khm##W (__a, __b); }					\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __ksll (V __a, unsigned __n)						\
+  { return __rv__v_ksll##W (__a, __n); }				\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __kslra (V __a, int __n)						\
+  { return __rv__v_kslra##W (__a, __n); }				\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __kabs (V __a)							\
+  { return __rv__v_kabs##W (__a); }					\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __smin (V __a, V __b)							\
+  { return __rv__v_smin##W (__a, __b); }				\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __smax (V __a, V __b)							\
+  { return __rv__v_smax##W (__a, __b); }				\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __scmpeq (V __a, V __b)						\
+  { return (V) __rv__v_scmpeq##W (__a, __b); }				\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __scmplt (V __a, V __b)						\
+  { return (V) __rv__v_scmplt##W (__a, __b); }				\
+  __RISCV_DSP_SIMD_INLINE V						\
+  __scmple (V __a, V __b)						\
+  { return (V) __rv__v_scmple##W (__a, __b); }
+
+#if __riscv_xlen == 32
+  __RISCV_DSP_SIMD_OPS (int16x2_t, uint16x2_t, 16)
+  __RISCV_DSP_SIMD_OPS (int8x4_t, uint8x4_t, 8)
+#else
+  __RISCV_DSP_SIMD_OPS (int16x4_t, uint16x4_t, 16)
+  __RISCV_DSP_SIMD_OPS (int8x8_t, uint8x8_t, 8)
+#endif
+
+#undef __RISCV_DSP_SIMD_OPS
+} // namespace __detail
+
+/* Evaluate lane by lane under constant evaluation, otherwise through
+   the intrinsic.  */
+#define __RISCV_DSP_SIMD_EVAL(T, FN, INTRIN, A, B)			\
+  (__builtin_is_constant_evaluated ()					\
+   ? T (__detail::__map (FN, (A), (B), _Index ()))			\
+   : T (INTRIN))
+
+  template<typename _Elt, int _N>
+    class basic_sat_q;
+
+  /* Lanes that wrap on overflow.  Also the lane mask type returned by
+     the comparisons: all ones where true, zero where false.  */
+  template<typename _Elt, int _N>
+    class basic_q
+    {
+      typedef typename __detail::__make_index<_N>::__type _Index;
+
+    public:
+      typedef _Elt value_type;
+      typedef typename __detail::__vec<_Elt, _N>::__type native_type;
+
+      static constexpr int
+      size ()
+      { return _N; }
+
+      constexpr
+      basic_q ()
+      : _M_v () { }
+
+      explicit constexpr
+      basic_q (native_type __v)
+      : _M_v (__v) { }
+
+      /* Lane 0 first; lanes not given are zero.  */
+      template<typename... _Args>
+	constexpr
+	basic_q (_Elt __l0, _Elt __l1, _Args... __ln)
+	: _M_v{ __l0, __l1, _Elt (__ln)... }
+	{ static_assert (sizeof... (_Args) + 2 <= _N, "too many lanes"); }
+
+      explicit constexpr
+      basic_q (const basic_sat_q<_Elt, _N> &__x)
+      : _M_v (__x.native ()) { }
+
+      static constexpr basic_q
+      splat (_Elt __x)
+      { return basic_q (__detail::__splat<native_type> (__x, _Index ())); }
+
+      constexpr native_type
+      native () const
+      { return _M_v; }
+
+      constexpr _Elt
+      operator[] (int __i) const
+      { return _M_v[__i]; }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator+ (basic_q __a, basic_q __b)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_q, __detail::__wrap_add (),
+				      __detail::__add (__a._M_v, __b._M_v),
+				      __a._M_v, __b._M_v);
+      }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator- (basic_q __a, basic_q __b)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_q, __detail::__wrap_sub (),
+				      __detail::__sub (__a._M_v, __b._M_v),
+				      __a._M_v, __b._M_v);
+      }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator- (basic_q __a)
+      { return basic_q () - __a; }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator<< (basic_q __a, unsigned __n)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_q, __detail::__wrap_shl{ __n },
+				      __detail::__sll (__a._M_v, __n),
+				      __a._M_v, __a._M_v);
+      }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator>> (basic_q __a, unsigned __n)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_q, __detail::__shr{ __n },
+				      __detail::__sra (__a._M_v, __n),
+				      __a._M_v, __a._M_v);
+      }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator& (basic_q __a, basic_q __b)
+      { return basic_q (__a._M_v & __b._M_v); }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator| (basic_q __a, basic_q __b)
+      { return basic_q (__a._M_v | __b._M_v); }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator^ (basic_q __a, basic_q __b)
+      { return basic_q (__a._M_v ^ __b._M_v); }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator~ (basic_q __a)
+      { return basic_q (~__a._M_v); }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator== (basic_q __a, basic_q __b)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_q, __detail::__cmpeq (),
+				      __detail::__scmpeq (__a._M_v, __b._M_v),
+				      __a._M_v, __b._M_v);
+      }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator!= (basic_q __a, basic_q __b)
+      { return ~(__a == __b); }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator< (basic_q __a, basic_q __b)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_q, __detail::__cmplt (),
+				      __detail::__scmplt (__a._M_v, __b._M_v),
+				      __a._M_v, __b._M_v);
+      }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator<= (basic_q __a, basic_q __b)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_q, __detail::__cmple (),
+				      __detail::__scmple (__a._M_v, __b._M_v),
+				      __a._M_v, __b._M_v);
+      }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator> (basic_q __a, basic_q __b)
+      { return __b < __a; }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      operator>= (basic_q __a, basic_q __b)
+      { return __b <= __a; }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      min (basic_q __a, basic_q __b)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_q, __detail::__min (),
+				      __detail::__smin (__a._M_v, __b._M_v),
+				      __a._M_v, __b._M_v);
+      }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      max (basic_q __a, basic_q __b)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_q, __detail::__max (),
+				      __detail::__smax (__a._M_v, __b._M_v),
+				      __a._M_v, __b._M_v);
+      }
+
+      /* Lanes of __a where __mask is set and of __b elsewhere.  */
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_q
+      select (basic_q __mask, basic_q __a, basic_q __b)
+      { return (__a & __mask) | (__b & ~__mask); }
+
+      __RISCV_DSP_CXX14_CONSTEXPR basic_q &
+      operator+= (basic_q __b)
+      { return *this = *this + __b; }
+
+      __RISCV_DSP_CXX14_CONSTEXPR basic_q &
+      operator-= (basic_q __b)
+      { return *this = *this - __b; }
+
+      __RISCV_DSP_CXX14_CONSTEXPR basic_q &
+      operator<<= (unsigned __n)
+      { return *this = *this << __n; }
+
+      __RISCV_DSP_CXX14_CONSTEXPR basic_q &
+      operator>>= (unsigned __n)
+      { return *this = *this >> __n; }
+
+    private:
+      native_type _M_v;
+    };
+
+  /* Lanes that saturate on overflow.  */
+  template<typename _Elt, int _N>
+    class basic_sat_q
+    {
+      typedef typename __detail::__make_index<_N>::__type _Index;
+
+    public:
+      typedef _Elt value_type;
+      typedef typename __detail::__vec<_Elt, _N>::__type native_type;
+      typedef basic_q<_Elt, _N> mask_type;
+
+      static constexpr int
+      size ()
+      { return _N; }
+
+      constexpr
+      basic_sat_q ()
+      : _M_v () { }
+
+      explicit constexpr
+      basic_sat_q (native_type __v)
+      : _M_v (__v) { }
+
+      template<typename... _Args>
+	constexpr
+	basic_sat_q (_Elt __l0, _Elt __l1, _Args... __ln)
+	: _M_v{ __l0, __l1, _Elt (__ln)... }
+	{ static_assert (sizeof... (_Args) + 2 <= _N, "too many lanes"); }
+
+      explicit constexpr
+      basic_sat_q (const basic_q<_Elt, _N> &__x)
+      : _M_v (__x.native ()) { }
+
+      static constexpr basic_sat_q
+      splat (_Elt __x)
+      {
+	return basic_sat_q (__detail::__splat<native_type> (__x, _Index ()));
+      }
+
+      constexpr native_type
+      native () const
+      { return _M_v; }
+
+      constexpr _Elt
+      operator[] (int __i) const
+      { return _M_v[__i]; }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_sat_q
+      operator+ (basic_sat_q __a, basic_sat_q __b)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_sat_q, __detail::__sat_add (),
+				      __detail::__kadd (__a._M_v, __b._M_v),
+				      __a._M_v, __b._M_v);
+      }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_sat_q
+      operator- (basic_sat_q __a, basic_sat_q __b)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_sat_q, __detail::__sat_sub (),
+				      __detail::__ksub (__a._M_v, __b._M_v),
+				      __a._M_v, __b._M_v);
+      }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_sat_q
+      operator- (basic_sat_q __a)
+      { return basic_sat_q () - __a; }
+
+      /* Q-format product: (a * b) >> (width - 1), saturated.  */
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_sat_q
+      operator* (basic_sat_q __a, basic_sat_q __b)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_sat_q, __detail::__sat_mulh (),
+				      __detail::__khm (__a._M_v, __b._M_v),
+				      __a._M_v, __b._M_v);
+      }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_sat_q
+      operator<< (basic_sat_q __a, unsigned __n)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_sat_q,
+				      __detail::__sat_shl{ __n },
+				      __detail::__ksll (__a._M_v, __n),
+				      __a._M_v, __a._M_v);
+      }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_sat_q
+      operator>> (basic_sat_q __a, unsigned __n)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_sat_q, __detail::__shr{ __n },
+				      __detail::__sra (__a._M_v, __n),
+				      __a._M_v, __a._M_v);
+      }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE mask_type
+      operator== (basic_sat_q __a, basic_sat_q __b)
+      { return mask_type (__a) == mask_type (__b); }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE mask_type
+      operator!= (basic_sat_q __a, basic_sat_q __b)
+      { return mask_type (__a) != mask_type (__b); }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE mask_type
+      operator< (basic_sat_q __a, basic_sat_q __b)
+      { return mask_type (__a) < mask_type (__b); }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE mask_type
+      operator<= (basic_sat_q __a, basic_sat_q __b)
+      { return mask_type (__a) <= mask_type (__b); }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE mask_type
+      operator> (basic_sat_q __a, basic_sat_q __b)
+      { return mask_type (__b) < mask_type (__a); }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE mask_type
+      operator>= (basic_sat_q __a, basic_sat_q __b)
+      { return mask_type (__b) <= mask_type (__a); }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_sat_q
+      min (basic_sat_q __a, basic_sat_q __b)
+      { return basic_sat_q (min (mask_type (__a), mask_type (__b))); }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_sat_q
+      max (basic_sat_q __a, basic_sat_q __b)
+      { return basic_sat_q (max (mask_type (__a), mask_type (__b))); }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_sat_q
+      select (mask_type __mask, basic_sat_q __a, basic_sat_q __b)
+      {
+	return basic_sat_q (select (__mask, mask_type (__a),
+				    mask_type (__b)));
+      }
+
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_sat_q
+      abs (basic_sat_q __a)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_sat_q, __detail::__sat_abs (),
+				      __detail::__kabs (__a._M_v),
+				      __a._M_v, __a._M_v);
+      }
+
+      /* Shift left by __n if positive, saturating, and arithmetically
+	 right by -__n if negative.  */
+      friend constexpr __RISCV_DSP_SIMD_INLINE basic_sat_q
+      shift (basic_sat_q __a, int __n)
+      {
+	return __RISCV_DSP_SIMD_EVAL (basic_sat_q,
+				      __detail::__sat_shift{ __n },
+				      __detail::__kslra (__a._M_v, __n),
+				      __a._M_v, __a._M_v);
+      }
+
+      __RISCV_DSP_CXX14_CONSTEXPR basic_sat_q &
+      operator+= (basic_sat_q __b)
+      { return *this = *this + __b; }
+
+      __RISCV_DSP_CXX14_CONSTEXPR basic_sat_q &
+      operator-= (basic_sat_q __b)
+      { return *this = *this - __b; }
+
+      __RISCV_DSP_CXX14_CONSTEXPR basic_sat_q &
+      operator*= (basic_sat_q __b)
+      { return *this = *this * __b; }
+
+      __RISCV_DSP_CXX14_CONSTEXPR basic_sat_q &
+      operator<<= (unsigned __n)
+      { return *this = *this << __n; }
+
+      __RISCV_DSP_CXX14_CONSTEXPR basic_sat_q &
+      operator>>= (unsigned __n)
+      { return *this = *this >> __n; }
+
+    private:
+      native_type _M_v;
+    };
+
+#undef __RISCV_DSP_SIMD_EVAL
+
+#if __riscv_xlen == 32
+  typedef basic_q<int16_t, 2> q15x2;
+  typedef basic_q<int8_t, 4> q7x4;
+  typedef basic_sat_q<int16_t, 2> sat_q15x2;
+  typedef basic_sat_q<int8_t, 4> sat_q7x4;
+
+  typedef q15x2 q15xn;
+  typedef q7x4 q7xn;
+  typedef sat_q15x2 sat_q15xn;
+  typedef sat_q7x4 sat_q7xn;
+  typedef int32_t acc32xn;
+#else
+  typedef basic_q<int16_t, 4> q15x4;
+  typedef basic_q<int8_t, 8> q7x8;
+  typedef basic_sat_q<int16_t, 4> sat_q15x4;
+  typedef basic_sat_q<int8_t, 8> sat_q7x8;
+
+  typedef q15x4 q15xn;
+  typedef q7x8 q7xn;
+  typedef sat_q15x4 sat_q15xn;
+  typedef sat_q7x8 sat_q7xn;
+  typedef int32x2_t acc32xn;
+#endif
+
+  /* Saturating sum of the pairwise products of adjacent Q15 lanes.  */
+  __RISCV_DSP_SIMD_INLINE acc32xn
+  dot (sat_q15xn __a, sat_q15xn __b)
+  { return __rv__v_kmda (__a.native (), __b.native ()); }
+
+  __RISCV_DSP_SIMD_INLINE acc32xn
+  dot_acc (acc32xn __acc, sat_q15xn __a, sat_q15xn __b)
+  { return __rv__v_kmada (__acc, __a.native (), __b.native ()); }
+
+  /* Wrapping sum of the products of each group of four Q7 lanes.  */
+  __RISCV_DSP_SIMD_INLINE acc32xn
+  dot_acc (acc32xn __acc, q7xn __a, q7xn __b)
+  { return __rv__v_smaqa (__acc, __a.native (), __b.native ()); }
+} // namespace riscv_dsp
+
+#undef __RISCV_DSP_SIMD_INLINE
+#undef __RISCV_DSP_CXX14_CONSTEXPR
+
+#endif /* _GCC_RISCV_DSP_SIMD_H */
@@ -138,6 +138,23 @@ vsetvlmax_e##SEW##m##LMUL (void)						\
 
 _RVV_INT_ITERATOR (_RVVSETVL)
 
+/* Strip-mine a loop over N elements with vsetvl, so that no scalar
+   epilogue is needed: the body runs with VL = min (remaining, VLMAX) and
+   the last, shorter strip goes through the same vector code.  For trip
+   counts up to VLMAX, as in short DSP blocks, the body runs exactly once.
+
+     vsetvl_for (e32m4, vl, n)
+       {
+	 vse32_v_f32m4 (y, vfadd_vv_f32m4 (vle32_v_f32m4 (x, vl),
+					   vle32_v_f32m4 (y, vl), vl), vl);
+	 x += vl;
+	 y += vl;
+       }  */
+#define vsetvl_for(VTYPE, VL, N)					\
+  for (word_type VL, _rvv_rem_##VL = (N);				\
+       _rvv_rem_##VL > 0 && ((VL) = vsetvl_##VTYPE (_rvv_rem_##VL), 1);	\
+       _rvv_rem_##VL -= (VL))
+
 
 #define _RVV_INT_VEC_MOVE(SEW, LMUL, MLEN, T)				\
 __extension__ extern __inline vint##SEW##m##LMUL##_t			\
@@ -11383,5 +11400,225 @@ _RVV_WINT_ITERATOR_ARG (_RVV_WINT_PWADD, pwadd)
 
 #endif
 
+
+#ifdef __riscv_zvamo
+
+/* Scatter read-modify-write helpers built on the vector AMO instructions.
+   BASE[INDEX[i]] OP= VALUE[i] is performed for every i < N.  Each element
+   of a vector AMO is an individual atomic memory operation, so indices that
+   repeat within one strip (histogram bins, sparse gradient rows, bucket
+   counters) are all applied instead of losing updates as a gather /
+   modify / scatter sequence would.  INDEX holds element indices, not byte
+   offsets.  There are no intrinsics with a vector destination yet, so the
+   strip body is written in assembly and the old values are discarded.  */
+
+#if __riscv_v == 7000
+#define _RVV_AMO_LOAD(SEW) "vle.v"
+#else
+#define _RVV_AMO_LOAD(SEW) "vle" #SEW ".v"
+#endif
+
+#define _RVV_AMO_SCATTER(SEW, SHIFT, T, OP, NAME)			\
+__extension__ extern __inline void					\
+__attribute__ ((__always_inline__, __gnu_inline__, __artificial__))	\
+vamo##NAME##_scatter_##T (T##_t *base, const uint##SEW##_t *index,	\
+			  const T##_t *value, size_t n)			\
+{									\
+  word_type vl;								\
+  for (; n > 0; n -= vl, index += vl, value += vl)			\
+    __asm__ __volatile__ ("vsetvli\t%0,%1,e" #SEW ",m4\n\t"		\
+			  _RVV_AMO_LOAD (SEW) "\tv8,(%2)\n\t"		\
+			  _RVV_AMO_LOAD (SEW) "\tv16,(%3)\n\t"		\
+			  "vsll.vi\tv8,v8," #SHIFT "\n\t"		\
+			  "vamo" #OP "ei" #SEW ".v\tx0,(%4),v8,v16"	\
+			  : "=&r"(vl)					\
+			  : "r"(n), "r"(index), "r"(value), "r"(base)	\
+			  : "v8", "v9", "v10", "v11",			\
+			    "v16", "v17", "v18", "v19",			\
+			    "vl", "vtype", "memory");			\
+}
+
+#define _RVV_AMO_SCATTER_ITERATOR(SEW, SHIFT)				\
+_RVV_AMO_SCATTER (SEW, SHIFT, int##SEW, add, add)			\
+_RVV_AMO_SCATTER (SEW, SHIFT, uint##SEW, add, add)			\
+_RVV_AMO_SCATTER (SEW, SHIFT, int##SEW, min, min)			\
+_RVV_AMO_SCATTER (SEW, SHIFT, int##SEW, max, max)			\
+_RVV_AMO_SCATTER (SEW, SHIFT, uint##SEW, minu, min)			\
+_RVV_AMO_SCATTER (SEW, SHIFT, uint##SEW, maxu, max)			\
+_RVV_AMO_SCATTER (SEW, SHIFT, uint##SEW, and, and)			\
+_RVV_AMO_SCATTER (SEW, SHIFT, uint##SEW, or, or)			\
+_RVV_AMO_SCATTER (SEW, SHIFT, uint##SEW, xor, xor)
+
+_RVV_AMO_SCATTER_ITERATOR (32, 2)
+#if __riscv_xlen == 64
+_RVV_AMO_SCATTER_ITERATOR (64, 3)
+#endif
+
+/* Histogram of N byte-sized keys into 32-bit BINS, the common special
+   case of vamoadd_scatter_uint32 with an implicit value of one.  */
+__extension__ extern __inline void
+__attribute__ ((__always_inline__, __gnu_inline__, __artificial__))
+vamo_histogram_u8 (uint32_t *bins, const uint8_t *key, size_t n)
+{
+  word_type vl;
+  for (; n > 0; n -= vl, key += vl)
+    __asm__ __volatile__ ("vsetvli\t%0,%1,e32,m4\n\t"
+			  "vmv.v.i\tv16,1\n\t"
+#if __riscv_v == 7000
+			  "vlbu.v\tv8,(%2)\n\t"
+#else
+			  "vsetvli\tx0,%0,e8,m1\n\t"
+			  "vle8.v\tv4,(%2)\n\t"
+			  "vsetvli\tx0,%0,e32,m4\n\t"
+			  "vzext.vf4\tv8,v4\n\t"
+#endif
+			  "vsll.vi\tv8,v8,2\n\t"
+			  "vamoaddei32.v\tx0,(%3),v8,v16"
+			  : "=&r"(vl)
+			  : "r"(n), "r"(key), "r"(bins)
+			  : "v4", "v8", "v9", "v10", "v11",
+			    "v16", "v17", "v18", "v19",
+			    "vl", "vtype", "memory");
+}
+
+#endif
+
+
+/* bfloat16 <-> float32 conversion and dot-product helpers.  A bfloat16 is
+   the upper half of the IEEE single with the same exponent, so widening is
+   a zero-extend and a shift, and narrowing rounds away the low 16 bits to
+   nearest, ties to even.  Zvfbfmin and Zvfbfwma are used when the target
+   has them; otherwise the integer sequences below are used, so the helpers
+   work on any vector target.  bfloat16 data is passed as raw bits in
+   vuint16 registers.  */
+
+#define _RVV_BF16_CVT(LMUL, WLMUL, MLEN)				\
+__extension__ extern __inline vfloat32m##WLMUL##_t			\
+__attribute__ ((__always_inline__, __gnu_inline__, __artificial__))	\
+vcvt_bf16_f32m##WLMUL (vuint16m##LMUL##_t a, word_type vl)		\
+{									\
+  return vreinterpret_v_u32m##WLMUL##_f32m##WLMUL (			\
+	   vsll_vx_u32m##WLMUL (vwaddu_vx_u32m##WLMUL (a, 0, vl), 16, vl));\
+}									\
+__extension__ extern __inline vuint16m##LMUL##_t			\
+__attribute__ ((__always_inline__, __gnu_inline__, __artificial__))	\
+vcvt_f32_bf16m##LMUL (vfloat32m##WLMUL##_t a, word_type vl)		\
+{									\
+  vuint32m##WLMUL##_t x = vreinterpret_v_f32m##WLMUL##_u32m##WLMUL (a);	\
+  /* Add 0x7fff plus the lowest kept bit, then truncate.  */		\
+  vuint32m##WLMUL##_t r =						\
+    vadd_vv_u32m##WLMUL (x, vadd_vx_u32m##WLMUL (			\
+			      vand_vx_u32m##WLMUL (			\
+				vsrl_vx_u32m##WLMUL (x, 16, vl), 1, vl),\
+			      0x7fff, vl), vl);				\
+  /* NaNs are truncated and quieted instead so they cannot round to	\
+     infinity.  */							\
+  r = vmerge_vvm_u32m##WLMUL (vmfne_vv_f32m##WLMUL##_b##MLEN (a, a, vl),	\
+			      r, vor_vx_u32m##WLMUL (x, 0x400000, vl), vl);\
+  return vnsrl_wx_u16m##LMUL (r, 16, vl);				\
+}
+
+_RVV_BF16_CVT (1, 2, 16)
+_RVV_BF16_CVT (2, 4, 8)
+_RVV_BF16_CVT (4, 8, 4)
+
+/* DST[i] = (float) SRC[i] for i < N.  */
+__extension__ extern __inline void
+__attribute__ ((__always_inline__, __gnu_inline__, __artificial__))
+vbf16_to_f32 (float *dst, const bfloat16_t *src, size_t n)
+{
+  word_type vl;
+  for (; n > 0; n -= vl, src += vl, dst += vl)
+    {
+      vl = vsetvl_e32m8 (n);
+#ifdef __riscv_zvfbfmin
+      vse32_v_f32m8 (dst, vfwcvtbf16_f_f_v_f32m8 (vle16_v_bf16m4 (src, vl),
+						 vl), vl);
+#else
+      vse32_v_f32m8 (dst, vcvt_bf16_f32m8 (vle16_v_u16m4 ((const uint16_t *)
+							 src, vl), vl), vl);
+#endif
+    }
+}
+
+/* DST[i] = (bfloat16_t) SRC[i] for i < N.  With Zvfbfmin the rounding
+   follows frm, which is round to nearest, ties to even by default.  */
+__extension__ extern __inline void
+__attribute__ ((__always_inline__, __gnu_inline__, __artificial__))
+vf32_to_bf16 (bfloat16_t *dst, const float *src, size_t n)
+{
+  word_type vl;
+  for (; n > 0; n -= vl, src += vl, dst += vl)
+    {
+      vl = vsetvl_e32m8 (n);
+#ifdef __riscv_zvfbfmin
+      vse16_v_bf16m4 (dst, vfncvtbf16_f_f_w_bf16m4 (vle32_v_f32m8 (src, vl),
+						   vl), vl);
+#else
+      vse16_v_u16m4 ((uint16_t *) dst,
+		     vcvt_f32_bf16m4 (vle32_v_f32m8 (src, vl), vl), vl);
+#endif
+    }
+}
+
+/* ACC[i] += A[i] * B[i] for i < VL, the products widened to float.  */
+__extension__ extern __inline vfloat32m4_t
+__attribute__ ((__always_inline__, __gnu_inline__, __artificial__))
+vbf16_macc_f32m4 (vfloat32m4_t acc, const bfloat16_t *a,
+		  const bfloat16_t *b, word_type vl)
+{
+#ifdef __riscv_zvfbfwma
+  return vfwmaccbf16_vv_f32m4 (acc, vle16_v_bf16m2 (a, vl),
+			       vle16_v_bf16m2 (b, vl), vl);
+#else
+  return vfmacc_vv_f32m4 (acc,
+			  vcvt_bf16_f32m4 (vle16_v_u16m2 ((const uint16_t *) a,
+							  vl), vl),
+			  vcvt_bf16_f32m4 (vle16_v_u16m2 ((const uint16_t *) b,
+							  vl), vl), vl);
+#endif
+}
+
+/* Sum of A[i] * B[i] for i < N, accumulated in float.  The accumulator
+   is only ever updated at VLMAX, because tail elements are not preserved
+   across a shorter vl; the last partial strip is reduced on its own.  */
+__extension__ extern __inline float
+__attribute__ ((__always_inline__, __gnu_inline__, __artificial__))
+vbf16_dot_f32 (const bfloat16_t *a, const bfloat16_t *b, size_t n)
+{
+  const word_type vlmax = vsetvlmax_e32m4 ();
+  vfloat32m1_t sum = vfmv_v_f_f32m1 (0.0f, 1);
+  if (n >= vlmax)
+    {
+      vfloat32m4_t acc = vfmv_v_f_f32m4 (0.0f, vlmax);
+      for (; n >= vlmax; n -= vlmax, a += vlmax, b += vlmax)
+	acc = vbf16_macc_f32m4 (acc, a, b, vlmax);
+      sum = vfredusum_vs_f32m4_f32m1 (sum, acc, sum, vlmax);
+    }
+  if (n > 0)
+    {
+      const word_type vl = vsetvl_e32m4 (n);
+      sum = vfredusum_vs_f32m4_f32m1 (sum,
+				      vbf16_macc_f32m4 (vfmv_v_f_f32m4 (0.0f,
+									vl),
+							a, b, vl),
+				      sum, vl);
+    }
+  return vfmv_f_s_f32m1_f32 (sum);
+}
+
+/* Y[i] = sum over j < N of A[i * LDA + j] * X[j], for i < M: a row-major
+   bfloat16 matrix times a bfloat16 vector, accumulated and stored in
+   float.  */
+__extension__ extern __inline void
+__attribute__ ((__always_inline__, __gnu_inline__, __artificial__))
+vbf16_gemv_f32 (float *y, const bfloat16_t *a, size_t lda,
+		const bfloat16_t *x, size_t m, size_t n)
+{
+  size_t i;
+  for (i = 0; i < m; i++)
+    y[i] = vbf16_dot_f32 (a + i * lda, x, n);
+}
+
 #endif
 #endif
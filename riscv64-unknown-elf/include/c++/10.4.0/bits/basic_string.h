@@ -340,6 +340,25 @@ _GLIBCXX_BEGIN_NAMESPACE_CXX11
 	return __testoff ? __off : this->size() - __pos;
       }
 
+      // find(__s, __pos, __n) for the inline overloads.  The out-of-line
+      // member is compiled into libstdc++ for basic_string<char> and
+      // cannot use the vector search of these headers; a member template
+      // is instantiated by its callers instead.
+      template<typename _Up>
+	size_type
+	_M_find(const _Up* __s, size_type __pos, size_type __n) const
+	_GLIBCXX_NOEXCEPT
+	{
+#ifdef __riscv_vector
+	  if (__are_same<_Traits, char_traits<char> >::__value)
+	    return std::__rvv_find(reinterpret_cast<const char*>(this->data()),
+				   this->size(),
+				   reinterpret_cast<const char*>(__s),
+				   __pos, __n);
+#endif
+	  return this->find(__s, __pos, __n);
+	}
+
       // True if _Rep and source do not overlap.
       bool
       _M_disjunct(const _CharT* __s) const _GLIBCXX_NOEXCEPT
@@ -2372,7 +2391,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CXX11
       size_type
       find(const basic_string& __str, size_type __pos = 0) const
       _GLIBCXX_NOEXCEPT
-      { return this->find(__str.data(), __pos, __str.size()); }
+      { return this->_M_find(__str.data(), __pos, __str.size()); }
 
 #if __cplusplus >= 201703L
       /**
@@ -2387,7 +2406,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CXX11
 	noexcept(is_same<_Tp, __sv_type>::value)
 	{
 	  __sv_type __sv = __svt;
-	  return this->find(__sv.data(), __pos, __sv.size());
+	  return this->_M_find(__sv.data(), __pos, __sv.size());
 	}
 #endif // C++17
 
@@ -2405,7 +2424,7 @@ _GLIBCXX_BEGIN_NAMESPACE_CXX11
       find(const _CharT* __s, size_type __pos = 0) const _GLIBCXX_NOEXCEPT
       {
 	__glibcxx_requires_string(__s);
-	return this->find(__s, __pos, traits_type::length(__s));
+	return this->_M_find(__s, __pos, traits_type::length(__s));
       }
 
       /**
@@ -3423,6 +3442,25 @@ _GLIBCXX_END_NAMESPACE_CXX11
 	return __testoff ? __off : this->size() - __pos;
       }
 
+      // find(__s, __pos, __n) for the inline overloads.  The out-of-line
+      // member is compiled into libstdc++ for basic_string<char> and
+      // cannot use the vector search of these headers; a member template
+      // is instantiated by its callers instead.
+      template<typename _Up>
+	size_type
+	_M_find(const _Up* __s, size_type __pos, size_type __n) const
+	_GLIBCXX_NOEXCEPT
+	{
+#ifdef __riscv_vector
+	  if (__are_same<_Traits, char_traits<char> >::__value)
+	    return std::__rvv_find(reinterpret_cast<const char*>(this->data()),
+				   this->size(),
+				   reinterpret_cast<const char*>(__s),
+				   __pos, __n);
+#endif
+	  return this->find(__s, __pos, __n);
+	}
+
       // True if _Rep and source do not overlap.
       bool
       _M_disjunct(const _CharT* __s) const _GLIBCXX_NOEXCEPT
@@ -5282,7 +5320,7 @@ _GLIBCXX_END_NAMESPACE_CXX11
       size_type
       find(const basic_string& __str, size_type __pos = 0) const
       _GLIBCXX_NOEXCEPT
-      { return this->find(__str.data(), __pos, __str.size()); }
+      { return this->_M_find(__str.data(), __pos, __str.size()); }
 
       /**
        *  @brief  Find position of a C string.
@@ -5298,7 +5336,7 @@ _GLIBCXX_END_NAMESPACE_CXX11
       find(const _CharT* __s, size_type __pos = 0) const _GLIBCXX_NOEXCEPT
       {
 	__glibcxx_requires_string(__s);
-	return this->find(__s, __pos, traits_type::length(__s));
+	return this->_M_find(__s, __pos, traits_type::length(__s));
       }
 
       /**
@@ -5327,7 +5365,7 @@ _GLIBCXX_END_NAMESPACE_CXX11
 	noexcept(is_same<_Tp, __sv_type>::value)
 	{
 	  __sv_type __sv = __svt;
-	  return this->find(__sv.data(), __pos, __sv.size());
+	  return this->_M_find(__sv.data(), __pos, __sv.size());
 	}
 #endif // C++17
 
@@ -1205,6 +1205,20 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
       const _CharT* const __last = __data + __size;
       size_type __len = __size - __pos;
 
+#ifdef __riscv_vector
+      // Vector first/last-byte filter; see bits/char_traits_rvv.h.  The
+      // copy in libstdc++ is scalar; this serves C++20 and other implicit
+      // instantiations, the inline overloads go through _M_find.
+      if (__are_same<_Traits, char_traits<char> >::__value)
+	{
+	  const char* __p =
+	    std::__rvv_search(reinterpret_cast<const char*>(__first), __len,
+			      reinterpret_cast<const char*>(__s), __n);
+	  return __p ? size_type(reinterpret_cast<const _CharT*>(__p) - __data)
+		     : npos;
+	}
+#endif
+
       while (__len >= __n)
 	{
 	  // Find the first occurrence of __elem0:
@@ -42,6 +42,9 @@
 #if __cplusplus > 201703L
 # include <compare>
 #endif
+#ifdef __riscv_vector
+# include <bits/char_traits_rvv.h>
+#endif
 
 #ifndef _GLIBCXX_ALWAYS_INLINE
 # define _GLIBCXX_ALWAYS_INLINE inline __attribute__((__always_inline__))
@@ -385,6 +388,10 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 		return 1;
 	    return 0;
 	  }
+#endif
+#ifdef __riscv_vector
+	if (!__builtin_constant_p(__n))
+	  return std::__rvv_memcmp(__s1, __s2, __n);
 #endif
 	return __builtin_memcmp(__s1, __s2, __n);
       }
@@ -395,6 +402,10 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 #if __cplusplus >= 201703L
 	if (__constant_string_p(__s))
 	  return __gnu_cxx::char_traits<char_type>::length(__s);
+#endif
+#ifdef __riscv_vector
+	if (!__builtin_constant_p(__builtin_strlen(__s)))
+	  return std::__rvv_strlen(__s);
 #endif
 	return __builtin_strlen(__s);
       }
@@ -409,6 +420,10 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 	    && __builtin_constant_p(__a)
 	    && __constant_char_array_p(__s, __n))
 	  return __gnu_cxx::char_traits<char_type>::find(__s, __n, __a);
+#endif
+#ifdef __riscv_vector
+	if (!__builtin_constant_p(__n))
+	  return std::__rvv_memchr(__s, __n, __a);
 #endif
 	return static_cast<const char_type*>(__builtin_memchr(__s, __a, __n));
       }
@@ -0,0 +1,153 @@
+// RISC-V vector kernels for character traits -*- C++ -*-
+
+// Copyright (C) 1997-2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file bits/char_traits_rvv.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{string}
+ */
+
+#ifndef _CHAR_TRAITS_RVV_H
+#define _CHAR_TRAITS_RVV_H 1
+
+#pragma GCC system_header
+
+#include <bits/c++config.h>
+#include <riscv_vector.h>
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  // Byte kernels behind char_traits<char> and basic_string<char>::find.
+  // They stream through the data at e8/m8, so one compare and one vfirst
+  // cover a whole register group per step.
+
+  /// Like memchr.
+  inline const char*
+  __rvv_memchr(const char* __s, size_t __n, char __c)
+  {
+    const uint8_t* __p = reinterpret_cast<const uint8_t*>(__s);
+    for (size_t __i = 0, __vl; __i < __n; __i += __vl)
+      {
+	__vl = vsetvl_e8m8(__n - __i);
+	const long __k =
+	  vfirst_m_b1(vmseq_vx_u8m8_b1(vle8_v_u8m8(__p + __i, __vl),
+				       uint8_t(__c), __vl), __vl);
+	if (__k >= 0)
+	  return __s + __i + __k;
+      }
+    return 0;
+  }
+
+  /// Like memcmp, returning the difference of the first unequal bytes.
+  inline int
+  __rvv_memcmp(const char* __s1, const char* __s2, size_t __n)
+  {
+    const uint8_t* __p1 = reinterpret_cast<const uint8_t*>(__s1);
+    const uint8_t* __p2 = reinterpret_cast<const uint8_t*>(__s2);
+    for (size_t __i = 0, __vl; __i < __n; __i += __vl)
+      {
+	__vl = vsetvl_e8m8(__n - __i);
+	const long __k =
+	  vfirst_m_b1(vmsne_vv_u8m8_b1(vle8_v_u8m8(__p1 + __i, __vl),
+				       vle8_v_u8m8(__p2 + __i, __vl), __vl),
+		      __vl);
+	if (__k >= 0)
+	  return int(__p1[__i + __k]) - int(__p2[__i + __k]);
+      }
+    return 0;
+  }
+
+  /// Like strlen.  Fault-only-first loads stop at the end of a mapping,
+  /// so reading ahead of the terminator is safe.
+  inline size_t
+  __rvv_strlen(const char* __s)
+  {
+    const uint8_t* __p = reinterpret_cast<const uint8_t*>(__s);
+    const size_t __vlmax = vsetvlmax_e8m8();
+    for (;;)
+      {
+	word_type __vl;
+	const vuint8m8_t __v = vle8ff_v_u8m8(__p, &__vl, __vlmax);
+	const long __k = vfirst_m_b1(vmseq_vx_u8m8_b1(__v, 0, __vl), __vl);
+	if (__k >= 0)
+	  return (__p + __k) - reinterpret_cast<const uint8_t*>(__s);
+	__p += __vl;
+      }
+  }
+
+  /// First occurrence of [__s, __s + __n) in [__h, __h + __hlen), or null.
+  /// Candidate positions are those where both the first and the last
+  /// byte of the needle match; only these are compared in full.
+  inline const char*
+  __rvv_search(const char* __h, size_t __hlen, const char* __s, size_t __n)
+  {
+    if (__n > __hlen)
+      return 0;
+    if (__n == 1)
+      return std::__rvv_memchr(__h, __hlen, __s[0]);
+
+    const uint8_t* __p = reinterpret_cast<const uint8_t*>(__h);
+    const uint8_t __first = __s[0];
+    const uint8_t __last = __s[__n - 1];
+    const size_t __count = __hlen - __n + 1;
+    for (size_t __i = 0, __vl; __i < __count; __i += __vl)
+      {
+	__vl = vsetvl_e8m8(__count - __i);
+	vbool1_t __m =
+	  vmand_mm_b1(vmseq_vx_u8m8_b1(vle8_v_u8m8(__p + __i, __vl),
+				       __first, __vl),
+		      vmseq_vx_u8m8_b1(vle8_v_u8m8(__p + __i + __n - 1, __vl),
+				       __last, __vl), __vl);
+	for (long __k; (__k = vfirst_m_b1(__m, __vl)) >= 0;)
+	  {
+	    const char* __cand = __h + __i + __k;
+	    if (std::__rvv_memcmp(__cand + 1, __s + 1, __n - 2) == 0)
+	      return __cand;
+	    // Drop this candidate and everything before it.
+	    __m = vmandn_mm_b1(__m, vmsif_m_b1(__m, __vl), __vl);
+	  }
+      }
+    return 0;
+  }
+
+  /// basic_string<char>::find(__s, __pos, __n) on [__data, __data + __size):
+  /// the index of the first occurrence at or after __pos, or size_t(-1).
+  inline size_t
+  __rvv_find(const char* __data, size_t __size, const char* __s,
+	     size_t __pos, size_t __n)
+  {
+    if (__n == 0)
+      return __pos <= __size ? __pos : size_t(-1);
+    if (__pos >= __size)
+      return size_t(-1);
+    const char* __p = std::__rvv_search(__data + __pos, __size - __pos,
+					__s, __n);
+    return __p ? size_t(__p - __data) : size_t(-1);
+  }
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif /* _CHAR_TRAITS_RVV_H */
@@ -194,7 +194,13 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     static size_t
     hash(const void* __ptr, size_t __clength,
 	 size_t __seed = static_cast<size_t>(0xc70f6907UL))
-    { return _Hash_bytes(__ptr, __clength, __seed); }
+    {
+#if defined(__riscv_vector) && __SIZEOF_SIZE_T__ == 8
+      if (__clength >= 64)
+	return __rvv_hash_bytes(__ptr, __clength, __seed);
+#endif
+      return _Hash_bytes(__ptr, __clength, __seed);
+    }
 
     template<typename _Tp>
       static size_t
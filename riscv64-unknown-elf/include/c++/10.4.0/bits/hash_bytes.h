@@ -33,6 +33,9 @@
 #pragma GCC system_header
 
 #include <bits/c++config.h>
+#if defined(__riscv_vector) && __SIZEOF_SIZE_T__ == 8
+# include <riscv_vector.h>
+#endif
 
 namespace std
 {
@@ -53,6 +56,44 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
   size_t
   _Fnv_hash_bytes(const void* __ptr, size_t __len, size_t __seed);
 
+#if defined(__riscv_vector) && __SIZEOF_SIZE_T__ == 8
+  // Same values as the 64-bit _Hash_bytes, which must not change while
+  // compiled code in the library depends on it.  Only the final
+  // h = (h ^ k) * mul step is serial, so the per-word mixing of k is done
+  // a vector of words at a time and the scalar chain just consumes it.
+  inline size_t
+  __rvv_hash_bytes(const void* __ptr, size_t __len, size_t __seed)
+  {
+    const size_t __mul = (size_t(0xc6a4a793UL) << 32) + size_t(0x5bd1e995UL);
+    const unsigned char* __p = static_cast<const unsigned char*>(__ptr);
+    const size_t __words = __len >> 3;
+    size_t __hash = __seed ^ (__len * __mul);
+    uint64_t __data[32];
+
+    for (size_t __i = 0, __vl; __i < __words; __i += __vl)
+      {
+	__vl = vsetvl_e64m4(__words - __i < 32 ? __words - __i : 32);
+	vuint64m4_t __k =
+	  vreinterpret_v_u8m4_u64m4(vle8_v_u8m4(__p + 8 * __i, 8 * __vl));
+	__k = vmul_vx_u64m4(__k, __mul, __vl);
+	__k = vxor_vv_u64m4(__k, vsrl_vx_u64m4(__k, 47, __vl), __vl);
+	vse64_v_u64m4(__data, vmul_vx_u64m4(__k, __mul, __vl), __vl);
+	for (size_t __j = 0; __j < __vl; ++__j)
+	  __hash = (__hash ^ __data[__j]) * __mul;
+      }
+    if (size_t __n = __len & 7)
+      {
+	const unsigned char* __end = __p + (__len & ~size_t(7));
+	size_t __tail = 0;
+	while (__n-- != 0)
+	  __tail = (__tail << 8) + __end[__n];
+	__hash = (__hash ^ __tail) * __mul;
+      }
+    __hash = (__hash ^ (__hash >> 47)) * __mul;
+    return __hash ^ (__hash >> 47);
+  }
+#endif
+
 _GLIBCXX_END_NAMESPACE_VERSION
 } // namespace
 
@@ -797,13 +797,28 @@ _GLIBCXX_END_NAMESPACE_LDBL
       _CharT* __buf = __bufend;
       if (__builtin_expect(__dec, true))
 	{
-	  // Decimal.
-	  do
+	  // Decimal, two digits per division.
+	  static const char __digits[201] =
+	    "0001020304050607080910111213141516171819"
+	    "2021222324252627282930313233343536373839"
+	    "4041424344454647484950515253545556575859"
+	    "6061626364656667686970717273747576777879"
+	    "8081828384858687888990919293949596979899";
+	  while (__v >= 100)
 	    {
-	      *--__buf = __lit[(__v % 10) + __num_base::_S_odigits];
-	      __v /= 10;
+	      const char* __d = __digits + (__v % 100) * 2;
+	      __v /= 100;
+	      *--__buf = __lit[(__d[1] - '0') + __num_base::_S_odigits];
+	      *--__buf = __lit[(__d[0] - '0') + __num_base::_S_odigits];
 	    }
-	  while (__v != 0);
+	  if (__v >= 10)
+	    {
+	      const char* __d = __digits + __v * 2;
+	      *--__buf = __lit[(__d[1] - '0') + __num_base::_S_odigits];
+	      *--__buf = __lit[(__d[0] - '0') + __num_base::_S_odigits];
+	    }
+	  else
+	    *--__buf = __lit[__v + __num_base::_S_odigits];
 	}
       else if ((__flags & ios_base::basefield) == ios_base::oct)
 	{
@@ -87,33 +87,61 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
       }
 
   template<typename _CharT, typename _Traits>
-    basic_ostream<_CharT, _Traits>&
-    basic_ostream<_CharT, _Traits>::
-    operator<<(short __n)
-    {
-      // _GLIBCXX_RESOLVE_LIB_DEFECTS
-      // 117. basic_ostream uses nonexistent num_put member functions.
-      const ios_base::fmtflags __fmt = this->flags() & ios_base::basefield;
-      if (__fmt == ios_base::oct || __fmt == ios_base::hex)
-	return _M_insert(static_cast<long>(static_cast<unsigned short>(__n)));
-      else
-	return _M_insert(static_cast<long>(__n));
-    }
+    template<typename _ValueT>
+      basic_ostream<_CharT, _Traits>&
+      basic_ostream<_CharT, _Traits>::
+      _M_insert_int(_ValueT __v)
+      {
+	// In the "C" locale num_put writes nothing but the digits and a
+	// minus sign unless there is padding or a prefix to add, and then
+	// there is no need to go through it.
+	const ios_base::fmtflags __flags = this->flags();
+	if (this->width() != 0
+	    || (__flags & (ios_base::showbase | ios_base::showpos))
+	    || !(this->_M_getloc() == locale::classic()))
+	  return _M_insert(__v);
+
+	sentry __cerb(*this);
+	if (__cerb)
+	  {
+	    typedef typename __gnu_cxx::__add_unsigned<_ValueT>::__type
+	      __unsigned_type;
+	    typedef __numpunct_cache<_CharT>	__cache_type;
+	    __use_cache<__cache_type> __uc;
+	    const _CharT* __lit = __uc(this->_M_getloc())->_M_atoms_out;
+	    ios_base::iostate __err = ios_base::goodbit;
+	    __try
+	      {
+		// Long enough to hold hex, dec, and octal representations.
+		const int __ilen = 5 * sizeof(_ValueT);
+		_CharT __cs[__ilen];
+		const ios_base::fmtflags __basefield
+		  = __flags & ios_base::basefield;
+		const bool __dec = (__basefield != ios_base::oct
+				    && __basefield != ios_base::hex);
+		const __unsigned_type __u = ((__v > 0 || !__dec)
+					     ? __unsigned_type(__v)
+					     : -__unsigned_type(__v));
+		int __len = std::__int_to_char(__cs + __ilen, __u, __lit,
+					       __flags, __dec);
+		if (__dec && __v < 0)
+		  __cs[__ilen - ++__len] = __lit[__num_base::_S_ominus];
+		if (this->rdbuf()->sputn(__cs + __ilen - __len, __len) != __len)
+		  __err |= ios_base::badbit;
+	      }
+	    __catch(__cxxabiv1::__forced_unwind&)
+	      {
+		this->_M_setstate(ios_base::badbit);
+		__throw_exception_again;
+	      }
+	    __catch(...)
+	      { this->_M_setstate(ios_base::badbit); }
+	    if (__err)
+	      this->setstate(__err);
+	  }
+	return *this;
+      }
 
-  template<typename _CharT, typename _Traits>
-    basic_ostream<_CharT, _Traits>&
-    basic_ostream<_CharT, _Traits>::
-    operator<<(int __n)
-    {
-      // _GLIBCXX_RESOLVE_LIB_DEFECTS
-      // 117. basic_ostream uses nonexistent num_put member functions.
-      const ios_base::fmtflags __fmt = this->flags() & ios_base::basefield;
-      if (__fmt == ios_base::oct || __fmt == ios_base::hex)
-	return _M_insert(static_cast<long>(static_cast<unsigned int>(__n)));
-      else
-	return _M_insert(static_cast<long>(__n));
-    }
-  
   template<typename _CharT, typename _Traits>
     basic_ostream<_CharT, _Traits>&
     basic_ostream<_CharT, _Traits>::
@@ -397,8 +397,14 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     {
       const _UIntType __upper_mask = (~_UIntType()) << __r;
       const _UIntType __lower_mask = ~__upper_mask;
+      size_t __k = 0;
 
-      for (size_t __k = 0; __k < (__n - __m); ++__k)
+#ifdef _GLIBCXX_OPT_HAVE_RANDOM_MT_GEN_RAND
+      __k = __detail::_Mt_twist<_UIntType>::_S_do_it(_M_x, __n, __m,
+						     __upper_mask, __a);
+#endif
+
+      for (; __k < (__n - __m); ++__k)
         {
 	  _UIntType __y = ((_M_x[__k] & __upper_mask)
 			   | (_M_x[__k + 1] & __lower_mask));
@@ -406,7 +412,7 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 		       ^ ((__y & 0x01) ? __a : 0));
         }
 
-      for (size_t __k = (__n - __m); __k < (__n - 1); ++__k)
+      for (; __k < (__n - 1); ++__k)
 	{
 	  _UIntType __y = ((_M_x[__k] & __upper_mask)
 			   | (_M_x[__k + 1] & __lower_mask));
@@ -66,6 +66,10 @@
 #include <bits/uniform_int_dist.h>
 #endif
 
+#ifdef __riscv_vector
+#include <bits/stl_algo_rvv.h>
+#endif
+
 // See concept_check.h for the __glibcxx_*_requires macros.
 
 namespace std _GLIBCXX_VISIBILITY(default)
@@ -2010,6 +2014,172 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
       std::__insertion_sort(__first, __last, __comp);
     }
 
+#ifdef __riscv_vector
+  // Introsort for contiguous arithmetic keys.  Partitions that are long
+  // enough go through the vcompress kernel instead of the swapping loop of
+  // __unguarded_partition, and leaves are sorted as they are reached by
+  // the in-register network, so no final insertion sort pass is needed.
+  // A pivot that nothing compares less than starts a run of equal keys,
+  // which is split off at once so that duplicates cannot degrade the
+  // recursion.
+  template<typename _Tp, typename _Size>
+    void
+    __rvv_introsort_loop(_Tp* __first, _Tp* __last, _Size __depth_limit)
+    {
+      __gnu_cxx::__ops::_Iter_less_iter __comp;
+      const ptrdiff_t __min = std::__rvv_partition_min_length<_Tp>();
+      while (__last - __first > int(_S_threshold))
+	{
+	  if (__depth_limit == 0)
+	    {
+	      std::__partial_sort(__first, __last, __last, __comp);
+	      return;
+	    }
+	  --__depth_limit;
+	  _Tp* __mid = __first + (__last - __first) / 2;
+	  std::__move_median_to_first(__first, __first + 1, __mid, __last - 1,
+				      __comp);
+	  if (__last - (__first + 1) < __min)
+	    {
+	      _Tp* __cut = std::__unguarded_partition(__first + 1, __last,
+						      __first, __comp);
+	      std::__rvv_introsort_loop(__cut, __last, __depth_limit);
+	      __last = __cut;
+	      continue;
+	    }
+	  _Tp* __cut = std::__rvv_partition_keys(__first + 1, __last,
+						 *__first, false);
+	  if (__cut == __first + 1)
+	    {
+	      __first = std::__rvv_partition_keys(__first + 1, __last,
+						  *__first, true);
+	      continue;
+	    }
+	  std::iter_swap(__first, __cut - 1);
+	  std::__rvv_introsort_loop(__cut, __last, __depth_limit);
+	  __last = __cut - 1;
+	}
+      if (!std::__rvv_sort_small_keys(__first, __last))
+	std::__insertion_sort(__first, __last, __comp);
+    }
+
+  template<typename _Tp, typename _Size>
+    void
+    __rvv_introselect(_Tp* __first, _Tp* __nth, _Tp* __last,
+		      _Size __depth_limit)
+    {
+      __gnu_cxx::__ops::_Iter_less_iter __comp;
+      const ptrdiff_t __min = std::__rvv_partition_min_length<_Tp>();
+      while (__last - __first > 3)
+	{
+	  if (__depth_limit == 0)
+	    {
+	      std::__heap_select(__first, __nth + 1, __last, __comp);
+	      // Place the nth largest element in its final position.
+	      std::iter_swap(__first, __nth);
+	      return;
+	    }
+	  --__depth_limit;
+	  _Tp* __mid = __first + (__last - __first) / 2;
+	  std::__move_median_to_first(__first, __first + 1, __mid, __last - 1,
+				      __comp);
+	  if (__last - (__first + 1) < __min)
+	    {
+	      _Tp* __cut = std::__unguarded_partition(__first + 1, __last,
+						      __first, __comp);
+	      if (__cut <= __nth)
+		__first = __cut;
+	      else
+		__last = __cut;
+	      continue;
+	    }
+	  _Tp* __cut = std::__rvv_partition_keys(__first + 1, __last,
+						 *__first, false);
+	  if (__cut == __first + 1)
+	    {
+	      // [__first, __cut) is now a run of keys equal to the pivot.
+	      __cut = std::__rvv_partition_keys(__first + 1, __last,
+						*__first, true);
+	      if (__nth < __cut)
+		return;
+	      __first = __cut;
+	      continue;
+	    }
+	  std::iter_swap(__first, __cut - 1);
+	  if (__nth == __cut - 1)
+	    return;
+	  if (__nth < __cut)
+	    __last = __cut - 1;
+	  else
+	    __first = __cut;
+	}
+      if (!std::__rvv_sort_small_keys(__first, __last))
+	std::__insertion_sort(__first, __last, __comp);
+    }
+
+  template<typename _Tp>
+    _GLIBCXX20_CONSTEXPR
+    inline typename __gnu_cxx::__enable_if<__rvv_sort_key<_Tp>::__value,
+					   void>::__type
+    __sort(_Tp* __first, _Tp* __last,
+	   __gnu_cxx::__ops::_Iter_less_iter __comp)
+    {
+      if (__first == __last)
+	return;
+#ifdef __cpp_lib_is_constant_evaluated
+      if (std::is_constant_evaluated())
+	{
+	  std::__introsort_loop(__first, __last,
+				std::__lg(__last - __first) * 2, __comp);
+	  std::__final_insertion_sort(__first, __last, __comp);
+	  return;
+	}
+#endif
+      std::__rvv_introsort_loop(__first, __last,
+				std::__lg(__last - __first) * 2);
+    }
+
+  template<typename _Tp, typename _Container>
+    _GLIBCXX20_CONSTEXPR
+    inline typename __gnu_cxx::__enable_if<__rvv_sort_key<_Tp>::__value,
+					   void>::__type
+    __sort(__gnu_cxx::__normal_iterator<_Tp*, _Container> __first,
+	   __gnu_cxx::__normal_iterator<_Tp*, _Container> __last,
+	   __gnu_cxx::__ops::_Iter_less_iter __comp)
+    { std::__sort(__first.base(), __last.base(), __comp); }
+
+  template<typename _Tp, typename _Size>
+    _GLIBCXX20_CONSTEXPR
+    inline typename __gnu_cxx::__enable_if<__rvv_sort_key<_Tp>::__value,
+					   void>::__type
+    __introselect(_Tp* __first, _Tp* __nth, _Tp* __last,
+		  _Size __depth_limit, __gnu_cxx::__ops::_Iter_less_iter __comp)
+    {
+#ifdef __cpp_lib_is_constant_evaluated
+      if (std::is_constant_evaluated())
+	{
+	  std::__introselect<_Tp*, _Size, __gnu_cxx::__ops::_Iter_less_iter>
+	    (__first, __nth, __last, __depth_limit, __comp);
+	  return;
+	}
+#endif
+      std::__rvv_introselect(__first, __nth, __last, __depth_limit);
+    }
+
+  template<typename _Tp, typename _Container, typename _Size>
+    _GLIBCXX20_CONSTEXPR
+    inline typename __gnu_cxx::__enable_if<__rvv_sort_key<_Tp>::__value,
+					   void>::__type
+    __introselect(__gnu_cxx::__normal_iterator<_Tp*, _Container> __first,
+		  __gnu_cxx::__normal_iterator<_Tp*, _Container> __nth,
+		  __gnu_cxx::__normal_iterator<_Tp*, _Container> __last,
+		  _Size __depth_limit, __gnu_cxx::__ops::_Iter_less_iter __comp)
+    {
+      std::__introselect(__first.base(), __nth.base(), __last.base(),
+			 __depth_limit, __comp);
+    }
+#endif
+
   // nth_element
 
   // lower_bound moved to stl_algobase.h
@@ -0,0 +1,285 @@
+// RISC-V vector kernels for sort and nth_element -*- C++ -*-
+
+// Copyright (C) 2001-2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file bits/stl_algo_rvv.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{algorithm}
+ */
+
+#ifndef _STL_ALGO_RVV_H
+#define _STL_ALGO_RVV_H 1
+
+#pragma GCC system_header
+
+#include <bits/c++config.h>
+#include <bits/cpp_type_traits.h>
+#include <ext/numeric_traits.h>
+#include <riscv_vector.h>
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  // Maps an element type to the key type the vector kernels work on.
+  // Only integers (of any width) and float/double qualify; everything
+  // else keeps the generic introsort.
+  template<size_t _Size, bool _Signed>
+    struct __rvv_sort_int
+    {
+      enum { __value = 0 };
+      typedef void __type;
+    };
+
+#define _GLIBCXX_RVV_SORT_INT(_Size, _Signed, _Kp)	\
+  template<>						\
+    struct __rvv_sort_int<_Size, _Signed>		\
+    {							\
+      enum { __value = 1 };				\
+      typedef _Kp __type;				\
+    };
+
+  _GLIBCXX_RVV_SORT_INT(1, true, int8_t)
+  _GLIBCXX_RVV_SORT_INT(1, false, uint8_t)
+  _GLIBCXX_RVV_SORT_INT(2, true, int16_t)
+  _GLIBCXX_RVV_SORT_INT(2, false, uint16_t)
+  _GLIBCXX_RVV_SORT_INT(4, true, int32_t)
+  _GLIBCXX_RVV_SORT_INT(4, false, uint32_t)
+  _GLIBCXX_RVV_SORT_INT(8, true, int64_t)
+  _GLIBCXX_RVV_SORT_INT(8, false, uint64_t)
+
+#undef _GLIBCXX_RVV_SORT_INT
+
+  template<typename _Tp, bool = __is_integer<_Tp>::__value>
+    struct __rvv_sort_key
+    : public __rvv_sort_int<sizeof(_Tp),
+			    __gnu_cxx::__numeric_traits<_Tp>::__is_signed>
+    { };
+
+  template<typename _Tp>
+    struct __rvv_sort_key<_Tp, false>
+    {
+      enum { __value = 0 };
+      typedef void __type;
+    };
+
+  template<>
+    struct __rvv_sort_key<float, false>
+    {
+      enum { __value = 1 };
+      typedef float __type;
+    };
+
+  template<>
+    struct __rvv_sort_key<double, false>
+    {
+      enum { __value = 1 };
+      typedef double __type;
+    };
+
+  // For each key type:
+  //
+  // __rvv_partition_min(__p) is the shortest range __rvv_partition accepts.
+  //
+  // __rvv_partition(__first, __last, __pivot, __inclusive) moves every
+  // element that is less than __pivot (not greater than __pivot if
+  // __inclusive) to the front of the range and returns the end of that
+  // prefix.  Each block is split with one compare, two vcompress and two
+  // unit-stride stores.  The two outermost blocks are held in registers
+  // first, so whichever side is read next always has a full block of
+  // free space for the results and the partition runs in place.
+  //
+  // __rvv_sort_small(__first, __n) sorts up to one register group of
+  // keys (and at most 256 bytes, whose lane ids fit in 8 bits) with an
+  // odd-even transposition network built from slides and merges, and
+  // returns false if __n does not fit.  A swap happens only
+  // when one key compares less than the other, so NaNs stay in the range.
+#define _GLIBCXX_RVV_SORT_KERNELS(_Kp, _Vt, _Sfx, _Sew, _Mlen,		\
+				  _Lt, _Ltx, _Gtx)			\
+  inline ptrdiff_t							\
+  __rvv_partition_min(const _Kp*)					\
+  { return 2 * ptrdiff_t(vsetvlmax_e##_Sew##m4()); }			\
+									\
+  inline void								\
+  __rvv_partition_block(v##_Vt##m4_t __v, size_t __vl, _Kp __pivot,	\
+			bool __inclusive, _Kp*& __lw, _Kp*& __rw)	\
+  {									\
+    const vbool##_Mlen##_t __lo = __inclusive				\
+      ? vmnot_m_b##_Mlen(v##_Gtx##_##_Sfx##m4_b##_Mlen(__v, __pivot,	\
+						       __vl), __vl)	\
+      : v##_Ltx##_##_Sfx##m4_b##_Mlen(__v, __pivot, __vl);		\
+    const size_t __n = vcpop_m_b##_Mlen(__lo, __vl);			\
+    vse##_Sew##_v_##_Sfx##m4(__lw, vcompress_vm_##_Sfx##m4(__lo, __v,	\
+							    __v, __vl),	\
+			     __n);					\
+    __lw += __n;							\
+    __rw -= __vl - __n;							\
+    vse##_Sew##_v_##_Sfx##m4(__rw,					\
+			     vcompress_vm_##_Sfx##m4(			\
+			       vmnot_m_b##_Mlen(__lo, __vl), __v, __v,	\
+			       __vl),					\
+			     __vl - __n);				\
+  }									\
+									\
+  inline _Kp*								\
+  __rvv_partition(_Kp* __first, _Kp* __last, _Kp __pivot,		\
+		  bool __inclusive)					\
+  {									\
+    const size_t __vlmax = vsetvlmax_e##_Sew##m4();			\
+    const v##_Vt##m4_t __head =						\
+      vle##_Sew##_v_##_Sfx##m4(__first, __vlmax);			\
+    const v##_Vt##m4_t __tail =						\
+      vle##_Sew##_v_##_Sfx##m4(__last - __vlmax, __vlmax);		\
+    _Kp* __lw = __first;						\
+    _Kp* __rw = __last;							\
+    _Kp* __lr = __first + __vlmax;					\
+    _Kp* __rr = __last - __vlmax;					\
+    while (size_t(__rr - __lr) >= __vlmax)				\
+      {									\
+	v##_Vt##m4_t __v;						\
+	if (__lr - __lw <= __rw - __rr)					\
+	  {								\
+	    __v = vle##_Sew##_v_##_Sfx##m4(__lr, __vlmax);		\
+	    __lr += __vlmax;						\
+	  }								\
+	else								\
+	  {								\
+	    __rr -= __vlmax;						\
+	    __v = vle##_Sew##_v_##_Sfx##m4(__rr, __vlmax);		\
+	  }								\
+	std::__rvv_partition_block(__v, __vlmax, __pivot, __inclusive,	\
+				   __lw, __rw);				\
+      }									\
+    if (__rr != __lr)							\
+      {									\
+	const size_t __vl = __rr - __lr;				\
+	std::__rvv_partition_block(vle##_Sew##_v_##_Sfx##m4(__lr, __vl),	\
+				   __vl, __pivot, __inclusive,		\
+				   __lw, __rw);				\
+      }									\
+    std::__rvv_partition_block(__head, __vlmax, __pivot, __inclusive,	\
+			       __lw, __rw);				\
+    std::__rvv_partition_block(__tail, __vlmax, __pivot, __inclusive,	\
+			       __lw, __rw);				\
+    return __lw;							\
+  }									\
+									\
+  inline bool								\
+  __rvv_sort_small(_Kp* __first, size_t __n)				\
+  {									\
+    /* The lane ids are _Sew bits wide: at SEW=8 they wrap past 255	\
+       once VLEN reaches 1024.  */					\
+    if (__n > vsetvlmax_e##_Sew##m4() || (_Sew == 8 && __n > 256))	\
+      return false;							\
+    const vuint##_Sew##m4_t __id = vid_v_u##_Sew##m4(__n);		\
+    const vbool##_Mlen##_t __odd =					\
+      vmseq_vx_u##_Sew##m4_b##_Mlen(vand_vx_u##_Sew##m4(__id, 1, __n),	\
+				    1, __n);				\
+    const vbool##_Mlen##_t __even = vmnot_m_b##_Mlen(__odd, __n);	\
+    const vbool##_Mlen##_t __inner =					\
+      vmsltu_vx_u##_Sew##m4_b##_Mlen(__id, __n - 1, __n);		\
+    v##_Vt##m4_t __v = vle##_Sew##_v_##_Sfx##m4(__first, __n);		\
+    for (size_t __round = 0; __round < __n; ++__round)			\
+      {									\
+	/* Pairs start on even lanes in even rounds, odd lanes in odd	\
+	   rounds.  */							\
+	const vbool##_Mlen##_t __lo =					\
+	  vmand_mm_b##_Mlen(__round & 1 ? __odd : __even, __inner, __n);\
+	const vbool##_Mlen##_t __hi = __round & 1 ? __even : __odd;	\
+	const v##_Vt##m4_t __next =					\
+	  vslidedown_vx_##_Sfx##m4(__v, __v, 1, __n);			\
+	const v##_Vt##m4_t __prev =					\
+	  vslideup_vx_##_Sfx##m4(__v, __v, 1, __n);			\
+	const v##_Vt##m4_t __w =					\
+	  vmerge_vvm_##_Sfx##m4(					\
+	    vmand_mm_b##_Mlen(__lo, v##_Lt##_vv_##_Sfx##m4_b##_Mlen(	\
+				      __next, __v, __n), __n),		\
+	    __v, __next, __n);						\
+	__v = vmerge_vvm_##_Sfx##m4(					\
+	  vmand_mm_b##_Mlen(__hi, v##_Lt##_vv_##_Sfx##m4_b##_Mlen(	\
+				    __v, __prev, __n), __n),		\
+	  __w, __prev, __n);						\
+      }									\
+    vse##_Sew##_v_##_Sfx##m4(__first, __v, __n);			\
+    return true;							\
+  }
+
+  _GLIBCXX_RVV_SORT_KERNELS(int8_t, int8, i8, 8, 2,
+			    mslt, mslt_vx, msgt_vx)
+  _GLIBCXX_RVV_SORT_KERNELS(uint8_t, uint8, u8, 8, 2,
+			    msltu, msltu_vx, msgtu_vx)
+  _GLIBCXX_RVV_SORT_KERNELS(int16_t, int16, i16, 16, 4,
+			    mslt, mslt_vx, msgt_vx)
+  _GLIBCXX_RVV_SORT_KERNELS(uint16_t, uint16, u16, 16, 4,
+			    msltu, msltu_vx, msgtu_vx)
+  _GLIBCXX_RVV_SORT_KERNELS(int32_t, int32, i32, 32, 8,
+			    mslt, mslt_vx, msgt_vx)
+  _GLIBCXX_RVV_SORT_KERNELS(uint32_t, uint32, u32, 32, 8,
+			    msltu, msltu_vx, msgtu_vx)
+  _GLIBCXX_RVV_SORT_KERNELS(int64_t, int64, i64, 64, 16,
+			    mslt, mslt_vx, msgt_vx)
+  _GLIBCXX_RVV_SORT_KERNELS(uint64_t, uint64, u64, 64, 16,
+			    msltu, msltu_vx, msgtu_vx)
+  _GLIBCXX_RVV_SORT_KERNELS(float, float32, f32, 32, 8,
+			    mflt, mflt_vf, mfgt_vf)
+  _GLIBCXX_RVV_SORT_KERNELS(double, float64, f64, 64, 16,
+			    mflt, mflt_vf, mfgt_vf)
+
+#undef _GLIBCXX_RVV_SORT_KERNELS
+
+  // Typed front ends for stl_algo.h: _Tp is the element type, the
+  // kernels see it as the key type of the same size and signedness.
+  template<typename _Tp>
+    inline ptrdiff_t
+    __rvv_partition_min_length()
+    {
+      typedef typename __rvv_sort_key<_Tp>::__type _Kp;
+      return std::__rvv_partition_min(static_cast<const _Kp*>(0));
+    }
+
+  template<typename _Tp>
+    inline _Tp*
+    __rvv_partition_keys(_Tp* __first, _Tp* __last, _Tp __pivot,
+			 bool __inclusive)
+    {
+      typedef typename __rvv_sort_key<_Tp>::__type _Kp;
+      _Kp* __kfirst = reinterpret_cast<_Kp*>(__first);
+      _Kp* __kmid = std::__rvv_partition(__kfirst,
+					 __kfirst + (__last - __first),
+					 _Kp(__pivot), __inclusive);
+      return __first + (__kmid - __kfirst);
+    }
+
+  template<typename _Tp>
+    inline bool
+    __rvv_sort_small_keys(_Tp* __first, _Tp* __last)
+    {
+      typedef typename __rvv_sort_key<_Tp>::__type _Kp;
+      return std::__rvv_sort_small(reinterpret_cast<_Kp*>(__first),
+				   __last - __first);
+    }
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif /* _STL_ALGO_RVV_H */
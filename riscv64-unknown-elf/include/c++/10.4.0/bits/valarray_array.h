@@ -38,6 +38,7 @@
 #include <bits/cpp_type_traits.h>
 #include <cstdlib>
 #include <new>
+#include <bits/valarray_rvv.h>
 
 namespace std _GLIBCXX_VISIBILITY(default)
 {
@@ -169,6 +170,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     __valarray_copy_construct (const _Tp* __restrict__ __a, size_t __n,
 			       size_t __s, _Tp* __restrict__ __o)
     {
+      if (__rvv_valarray<_Tp>::_S_copy(__a, __n, __s, __o))
+	return;
       if (__is_trivial(_Tp))
 	while (__n--)
 	  {
@@ -190,6 +193,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 			       const size_t* __restrict__ __i,
 			       _Tp* __restrict__ __o, size_t __n)
     {
+      if (__rvv_valarray<_Tp>::_S_copy(__a, __i, __o, __n))
+	return;
       if (__is_trivial(_Tp))
 	while (__n--)
 	  *__o++ = __a[*__i++];
@@ -216,6 +221,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     inline void
     __valarray_fill(_Tp* __restrict__ __a, size_t __n, const _Tp& __t)
     {
+      if (__rvv_valarray<_Tp>::_S_fill(__a, __n, __t))
+	return;
       while (__n--)
 	*__a++ = __t;
     }
@@ -226,6 +233,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     __valarray_fill(_Tp* __restrict__ __a, size_t __n,
 		    size_t __s, const _Tp& __t)
     { 
+      if (__rvv_valarray<_Tp>::_S_fill(__a, __n, __s, __t))
+	return;
       for (size_t __i = 0; __i < __n; ++__i, __a += __s)
 	*__a = __t;
     }
@@ -279,6 +288,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     __valarray_copy(const _Tp* __restrict__ __a, size_t __n, size_t __s,
 		    _Tp* __restrict__ __b)
     {
+      if (__rvv_valarray<_Tp>::_S_copy(__a, __n, __s, __b))
+	return;
       for (size_t __i = 0; __i < __n; ++__i, ++__b, __a += __s)
 	*__b = *__a;
     }
@@ -289,6 +300,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     __valarray_copy(const _Tp* __restrict__ __a, _Tp* __restrict__ __b,
 		    size_t __n, size_t __s)
     {
+      if (__rvv_valarray<_Tp>::_S_copy(__a, __b, __n, __s))
+	return;
       for (size_t __i = 0; __i < __n; ++__i, ++__a, __b += __s)
 	*__b = *__a;
     }
@@ -300,6 +313,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     __valarray_copy(const _Tp* __restrict__ __src, size_t __n, size_t __s1,
 		    _Tp* __restrict__ __dst, size_t __s2)
     {
+      if (__rvv_valarray<_Tp>::_S_copy(__src, __n, __s1, __dst, __s2))
+	return;
       for (size_t __i = 0; __i < __n; ++__i)
 	__dst[__i * __s2] = __src[__i * __s1];
     }
@@ -311,6 +326,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 		    const size_t* __restrict__ __i,
 		    _Tp* __restrict__ __b, size_t __n)
     {
+      if (__rvv_valarray<_Tp>::_S_copy(__a, __i, __b, __n))
+	return;
       for (size_t __j = 0; __j < __n; ++__j, ++__b, ++__i)
 	*__b = __a[*__i];
     }
@@ -321,6 +338,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     __valarray_copy(const _Tp* __restrict__ __a, size_t __n,
 		    _Tp* __restrict__ __b, const size_t* __restrict__ __i)
     {
+      if (__rvv_valarray<_Tp>::_S_copy(__a, __n, __b, __i))
+	return;
       for (size_t __j = 0; __j < __n; ++__j, ++__a, ++__i)
 	__b[*__i] = *__a;
     }
@@ -513,6 +532,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     inline void								\
     _Array_augmented_##_Name(_Array<_Tp> __a, size_t __n, const _Tp& __t) \
     {									\
+      if (__rvv_valarray_augmented<_Name>(__a._M_data, __t, __n))	\
+	return;								\
       for (_Tp* __p = __a._M_data; __p < __a._M_data + __n; ++__p)	\
         *__p _Op##= __t;						\
     }									\
@@ -521,6 +542,9 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     inline void								\
     _Array_augmented_##_Name(_Array<_Tp> __a, size_t __n, _Array<_Tp> __b) \
     {									\
+      if (__rvv_valarray_augmented<_Name>(__a._M_data,			\
+					  (const _Tp*)__b._M_data, __n))	\
+	return;								\
       _Tp* __p = __a._M_data;						\
       for (_Tp* __q = __b._M_data; __q < __b._M_data + __n; ++__p, ++__q) \
         *__p _Op##= *__q;						\
@@ -531,6 +555,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     _Array_augmented_##_Name(_Array<_Tp> __a,	        		\
                              const _Expr<_Dom, _Tp>& __e, size_t __n)	\
     {									\
+      if (__rvv_valarray_augmented<_Name>(__a._M_data, __e(), __n))	\
+	return;								\
       _Tp* __p(__a._M_data);						\
       for (size_t __i = 0; __i < __n; ++__i, ++__p)                     \
         *__p _Op##= __e[__i];                                          	\
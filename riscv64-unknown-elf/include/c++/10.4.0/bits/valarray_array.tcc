@@ -141,6 +141,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     void
     __valarray_copy(const _Expr<_Dom, _Tp>& __e, size_t __n, _Array<_Tp> __a)
     {
+      if (__rvv_valarray_eval<_Dom>::_S_copy(__e(), __n, __a._M_data))
+	return;
       _Tp* __p (__a._M_data);
       for (size_t __i = 0; __i < __n; ++__i, ++__p)
 	*__p = __e[__i];
@@ -153,6 +155,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     __valarray_copy(const _Expr<_Dom, _Tp>& __e, size_t __n,
 		     _Array<_Tp> __a, size_t __s)
     {
+      if (__rvv_valarray_eval<_Dom>::_S_copy(__e(), __n, __a._M_data, __s))
+	return;
       _Tp* __p (__a._M_data);
       for (size_t __i = 0; __i < __n; ++__i, __p += __s)
 	*__p = __e[__i];
@@ -214,6 +218,8 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     __valarray_copy_construct(const _Expr<_Dom, _Tp>& __e, size_t __n,
 			      _Array<_Tp> __a)
     {
+      if (__rvv_valarray_eval<_Dom>::_S_copy(__e(), __n, __a._M_data))
+	return;
       _Tp* __p (__a._M_data);
       for (size_t __i = 0; __i < __n; ++__i, ++__p)
 	new (__p) _Tp(__e[__i]);
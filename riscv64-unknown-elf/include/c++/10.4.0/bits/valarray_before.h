@@ -504,6 +504,8 @@ namespace __detail
       size_t size() const { return _M_expr.size(); }
       
     private:
+      template<class> friend struct std::__rvv_valarray_expr;
+
       typename _ValArrayRef<_Arg>::__type _M_expr;
     };
 
@@ -550,6 +552,8 @@ namespace __detail
       size_t size() const { return _M_expr1.size(); }
 
     private:
+      template<class> friend struct std::__rvv_valarray_expr;
+
       typename _ValArrayRef<_FirstArg>::__type _M_expr1;
       typename _ValArrayRef<_SecondArg>::__type _M_expr2;
     };
@@ -571,6 +575,8 @@ namespace __detail
       size_t size() const { return _M_expr1.size(); }
 
     private:
+      template<class> friend struct std::__rvv_valarray_expr;
+
       typename _ValArrayRef<_Clos>::__type _M_expr1;
       _Vt _M_expr2;
     };
@@ -591,6 +597,8 @@ namespace __detail
       size_t size() const { return _M_expr2.size(); }
 
     private:
+      template<class> friend struct std::__rvv_valarray_expr;
+
       _Vt _M_expr1;
       typename _ValArrayRef<_Clos>::__type _M_expr2;
     };
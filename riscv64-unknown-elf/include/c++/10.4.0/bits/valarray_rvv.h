@@ -0,0 +1,626 @@
+// RISC-V vector kernels for valarray -*- C++ -*-
+
+// Copyright (C) 1997-2020 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file bits/valarray_rvv.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{valarray}
+ */
+
+#ifndef _VALARRAY_RVV_H
+#define _VALARRAY_RVV_H 1
+
+#pragma GCC system_header
+
+#include <bits/c++config.h>
+#ifdef __riscv_vector
+# include <riscv_vector.h>
+#endif
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  struct __unary_plus;
+  struct __negate;
+  struct __plus;
+  struct __minus;
+  struct __multiplies;
+  struct __divides;
+  struct __modulus;
+  struct __bitwise_xor;
+  struct __bitwise_or;
+  struct __bitwise_and;
+  struct __shift_left;
+  struct __shift_right;
+
+namespace __detail
+{
+  template<class _Oper, class _Arg>
+    class _UnBase;
+
+  template<class _Oper, class _FirstArg, class _SecondArg>
+    class _BinBase;
+
+  template<class _Oper, class _Clos>
+    class _BinBase1;
+
+  template<class _Oper, class _Clos>
+    class _BinBase2;
+} // namespace __detail
+
+  // The helpers in valarray_array.h first offer their work to these
+  // classes, which return false unless they have done it.  On targets
+  // with the V extension arithmetic element types are strip-mined at
+  // LMUL 2, which leaves enough register groups for the temporaries of
+  // moderately deep expressions.
+
+  // Element-wise vector operations on _Tp.
+  template<typename _Tp>
+    struct __rvv_valarray_ops
+    {
+      enum { __value = 0, __indexed = 0 };
+      typedef void __vec;
+    };
+
+  // Whether _Oper has a vector implementation.
+  template<class _Oper>
+    struct __rvv_valarray_op
+    { enum { __value = 0 }; };
+
+  // How to evaluate a strip of the expression _Clos, if it can be.
+  template<class _Clos>
+    struct __rvv_valarray_expr
+    { enum { __value = 0 }; };
+
+  // Fills and copies on raw, strided and indexed storage.
+  template<typename _Tp, bool = __rvv_valarray_ops<_Tp>::__value>
+    struct __rvv_valarray
+    {
+      static bool
+      _S_fill(_Tp*, size_t, const _Tp&)
+      { return false; }
+
+      static bool
+      _S_fill(_Tp*, size_t, size_t, const _Tp&)
+      { return false; }
+
+      static bool
+      _S_copy(const _Tp*, size_t, size_t, _Tp*)
+      { return false; }
+
+      static bool
+      _S_copy(const _Tp*, _Tp*, size_t, size_t)
+      { return false; }
+
+      static bool
+      _S_copy(const _Tp*, size_t, size_t, _Tp*, size_t)
+      { return false; }
+
+      static bool
+      _S_copy(const _Tp*, const size_t*, _Tp*, size_t)
+      { return false; }
+
+      static bool
+      _S_copy(const _Tp*, size_t, _Tp*, const size_t*)
+      { return false; }
+    };
+
+  // Evaluation of a whole expression into plain or strided storage.
+  template<class _Clos, bool = __rvv_valarray_expr<_Clos>::__value>
+    struct __rvv_valarray_eval
+    {
+      template<typename _Tp>
+	static bool
+	_S_copy(const _Clos&, size_t, _Tp*)
+	{ return false; }
+
+      template<typename _Tp>
+	static bool
+	_S_copy(const _Clos&, size_t, _Tp*, size_t)
+	{ return false; }
+    };
+
+  // A node for __a[__i] _Oper __e[__i], used for the computed
+  // assignments.  Both operands are held by reference.
+  template<class _Oper, class _Arg1, class _Arg2>
+    struct __rvv_valarray_binary
+    {
+      const _Arg1& _M_arg1;
+      const _Arg2& _M_arg2;
+    };
+
+  // __a[<__n>] _Oper= __e, where __e is a scalar, plain array or
+  // expression.
+  template<class _Oper, typename _Tp, class _Arg>
+    inline bool
+    __rvv_valarray_augmented(_Tp* __a, const _Arg& __e, size_t __n)
+    {
+      typedef __rvv_valarray_binary<_Oper, _Tp*, _Arg> _Node;
+      const _Node __node = { __a, __e };
+      return __rvv_valarray_eval<_Node>::_S_copy(__node, __n, __a);
+    }
+
+#ifdef __riscv_vector
+
+#define _GLIBCXX_RVV_VALARRAY_OPS(_Tp, _Elt, _Sew, _Sfx, _Vec, _F, _Div, _Mv, \
+				  _Idx)					\
+  template<>								\
+    struct __rvv_valarray_ops<_Tp>					\
+    {									\
+      enum { __value = 1, __indexed = _Idx };				\
+      typedef _Vec __vec;						\
+      struct _Indexed;							\
+									\
+      static size_t							\
+      _S_setvl(size_t __n)						\
+      { return vsetvl_e##_Sew##m2(__n); }				\
+									\
+      static __vec							\
+      _S_load(const _Tp* __p, size_t __vl)				\
+      { return vle##_Sew##_v_##_Sfx##m2((const _Elt*)__p, __vl); }	\
+									\
+      static __vec							\
+      _S_load(const _Tp* __p, size_t __s, size_t __vl)			\
+      {									\
+	return vlse##_Sew##_v_##_Sfx##m2((const _Elt*)__p,		\
+					 __s * sizeof(_Tp), __vl);	\
+      }									\
+									\
+      static void							\
+      _S_store(_Tp* __p, __vec __v, size_t __vl)			\
+      { vse##_Sew##_v_##_Sfx##m2((_Elt*)__p, __v, __vl); }		\
+									\
+      static void							\
+      _S_store(_Tp* __p, size_t __s, __vec __v, size_t __vl)		\
+      {									\
+	vsse##_Sew##_v_##_Sfx##m2((_Elt*)__p, __s * sizeof(_Tp),	\
+				  __v, __vl);				\
+      }									\
+									\
+      static __vec							\
+      _S_splat(_Tp __x, size_t __vl)					\
+      { return v##_Mv##_##_Sfx##m2(__x, __vl); }			\
+									\
+      static __vec							\
+      _S_apply(const __unary_plus&, __vec __x, size_t)			\
+      { return __x; }							\
+									\
+      static __vec							\
+      _S_apply(const __negate&, __vec __x, size_t __vl)			\
+      { return v##_F##neg_v_##_Sfx##m2(__x, __vl); }			\
+									\
+      static __vec							\
+      _S_apply(const __plus&, __vec __x, __vec __y, size_t __vl)	\
+      { return v##_F##add_vv_##_Sfx##m2(__x, __y, __vl); }		\
+									\
+      static __vec							\
+      _S_apply(const __minus&, __vec __x, __vec __y, size_t __vl)	\
+      { return v##_F##sub_vv_##_Sfx##m2(__x, __y, __vl); }		\
+									\
+      static __vec							\
+      _S_apply(const __multiplies&, __vec __x, __vec __y, size_t __vl)	\
+      { return v##_F##mul_vv_##_Sfx##m2(__x, __y, __vl); }		\
+									\
+      static __vec							\
+      _S_apply(const __divides&, __vec __x, __vec __y, size_t __vl)	\
+      { return v##_Div##_vv_##_Sfx##m2(__x, __y, __vl); }		\
+    };									\
+									\
+  template<>								\
+    struct __rvv_valarray_expr<_Tp>					\
+    {									\
+      enum { __value = 1 };						\
+									\
+      static _Vec							\
+      _S_eval(const _Tp& __x, size_t, size_t __vl)			\
+      { return __rvv_valarray_ops<_Tp>::_S_splat(__x, __vl); }		\
+    };
+
+  // Gathers and scatters for gslice_array and indirect_array.  The
+  // size_t indices are scaled to byte offsets, at twice the data LMUL
+  // for 32-bit elements; V 0.7 has no 64-bit index for those.
+#if __SIZEOF_SIZE_T__ == 8
+# define _GLIBCXX_RVV_VALARRAY_IDX32 (__riscv_v != 7000)
+# define _GLIBCXX_RVV_VALARRAY_IDX64 1
+#else
+# define _GLIBCXX_RVV_VALARRAY_IDX32 0
+# define _GLIBCXX_RVV_VALARRAY_IDX64 0
+#endif
+
+#define _GLIBCXX_RVV_VALARRAY_INDEXED(_Tp, _Elt, _Sfx, _Ilmul, _Shift)	\
+  struct __rvv_valarray_ops<_Tp>::_Indexed				\
+  {									\
+    static vuint64##_Ilmul##_t						\
+    _S_offsets(const size_t* __i, size_t __vl)				\
+    {									\
+      return vsll_vx_u64##_Ilmul(vle64_v_u64##_Ilmul(__i, __vl),	\
+				 _Shift, __vl);				\
+    }									\
+									\
+    static __rvv_valarray_ops<_Tp>::__vec				\
+    _S_gather(const _Tp* __p, const size_t* __i, size_t __vl)		\
+    {									\
+      return vloxei64_v_##_Sfx##m2((const _Elt*)__p,			\
+				   _S_offsets(__i, __vl), __vl);	\
+    }									\
+									\
+    static void								\
+    _S_scatter(_Tp* __p, const size_t* __i,				\
+	       __rvv_valarray_ops<_Tp>::__vec __v, size_t __vl)		\
+    {									\
+      vsoxei64_v_##_Sfx##m2((_Elt*)__p, _S_offsets(__i, __vl),		\
+			    __v, __vl);					\
+    }									\
+  };
+
+  _GLIBCXX_RVV_VALARRAY_OPS(int, int32_t, 32, i32, vint32m2_t,
+			    , div, mv_v_x, _GLIBCXX_RVV_VALARRAY_IDX32)
+  _GLIBCXX_RVV_VALARRAY_OPS(unsigned int, uint32_t, 32, u32, vuint32m2_t,
+			    , divu, mv_v_x, _GLIBCXX_RVV_VALARRAY_IDX32)
+#if __SIZEOF_LONG__ == 8
+  _GLIBCXX_RVV_VALARRAY_OPS(long, int64_t, 64, i64, vint64m2_t,
+			    , div, mv_v_x, _GLIBCXX_RVV_VALARRAY_IDX64)
+  _GLIBCXX_RVV_VALARRAY_OPS(unsigned long, uint64_t, 64, u64, vuint64m2_t,
+			    , divu, mv_v_x, _GLIBCXX_RVV_VALARRAY_IDX64)
+#else
+  _GLIBCXX_RVV_VALARRAY_OPS(long, int32_t, 32, i32, vint32m2_t,
+			    , div, mv_v_x, _GLIBCXX_RVV_VALARRAY_IDX32)
+  _GLIBCXX_RVV_VALARRAY_OPS(unsigned long, uint32_t, 32, u32, vuint32m2_t,
+			    , divu, mv_v_x, _GLIBCXX_RVV_VALARRAY_IDX32)
+#endif
+  _GLIBCXX_RVV_VALARRAY_OPS(long long, int64_t, 64, i64, vint64m2_t,
+			    , div, mv_v_x, _GLIBCXX_RVV_VALARRAY_IDX64)
+  _GLIBCXX_RVV_VALARRAY_OPS(unsigned long long, uint64_t, 64, u64,
+			    vuint64m2_t, , divu, mv_v_x,
+			    _GLIBCXX_RVV_VALARRAY_IDX64)
+  _GLIBCXX_RVV_VALARRAY_OPS(float, float, 32, f32, vfloat32m2_t,
+			    f, fdiv, fmv_v_f, _GLIBCXX_RVV_VALARRAY_IDX32)
+  _GLIBCXX_RVV_VALARRAY_OPS(double, double, 64, f64, vfloat64m2_t,
+			    f, fdiv, fmv_v_f, _GLIBCXX_RVV_VALARRAY_IDX64)
+
+#if _GLIBCXX_RVV_VALARRAY_IDX32
+  _GLIBCXX_RVV_VALARRAY_INDEXED(int, int32_t, i32, m4, 2)
+  _GLIBCXX_RVV_VALARRAY_INDEXED(unsigned int, uint32_t, u32, m4, 2)
+  _GLIBCXX_RVV_VALARRAY_INDEXED(float, float, f32, m4, 2)
+#endif
+#if _GLIBCXX_RVV_VALARRAY_IDX64
+  _GLIBCXX_RVV_VALARRAY_INDEXED(long, int64_t, i64, m2, 3)
+  _GLIBCXX_RVV_VALARRAY_INDEXED(unsigned long, uint64_t, u64, m2, 3)
+  _GLIBCXX_RVV_VALARRAY_INDEXED(long long, int64_t, i64, m2, 3)
+  _GLIBCXX_RVV_VALARRAY_INDEXED(unsigned long long, uint64_t, u64, m2, 3)
+  _GLIBCXX_RVV_VALARRAY_INDEXED(double, double, f64, m2, 3)
+#endif
+
+#undef _GLIBCXX_RVV_VALARRAY_OPS
+#undef _GLIBCXX_RVV_VALARRAY_INDEXED
+#undef _GLIBCXX_RVV_VALARRAY_IDX32
+#undef _GLIBCXX_RVV_VALARRAY_IDX64
+
+  template<> struct __rvv_valarray_op<__unary_plus> { enum { __value = 1 }; };
+  template<> struct __rvv_valarray_op<__negate> { enum { __value = 1 }; };
+  template<> struct __rvv_valarray_op<__plus> { enum { __value = 1 }; };
+  template<> struct __rvv_valarray_op<__minus> { enum { __value = 1 }; };
+  template<> struct __rvv_valarray_op<__multiplies> { enum { __value = 1 }; };
+  template<> struct __rvv_valarray_op<__divides> { enum { __value = 1 }; };
+
+  // Leaves: a plain array and a valarray.  Constants are handled by the
+  // per-type specializations above.
+  template<typename _Tp>
+    struct __rvv_valarray_expr<_Tp*>
+    {
+      enum { __value = __rvv_valarray_ops<_Tp>::__value };
+
+      static typename __rvv_valarray_ops<_Tp>::__vec
+      _S_eval(const _Tp* __p, size_t __i, size_t __vl)
+      { return __rvv_valarray_ops<_Tp>::_S_load(__p + __i, __vl); }
+    };
+
+  template<typename _Tp>
+    struct __rvv_valarray_expr<const _Tp*>
+    : __rvv_valarray_expr<_Tp*>
+    { };
+
+  template<typename _Tp>
+    struct __rvv_valarray_expr<valarray<_Tp> >
+    {
+      enum { __value = __rvv_valarray_ops<_Tp>::__value };
+
+      static typename __rvv_valarray_ops<_Tp>::__vec
+      _S_eval(const valarray<_Tp>& __v, size_t __i, size_t __vl)
+      { return __rvv_valarray_ops<_Tp>::_S_load(&__v[__i], __vl); }
+    };
+
+  // Interior nodes: the closures of valarray_before.h, and the node
+  // built for the computed assignments.
+  template<class _Oper, class _Arg>
+    struct __rvv_valarray_expr<__detail::_UnBase<_Oper, _Arg> >
+    {
+      typedef __detail::_UnBase<_Oper, _Arg> _Clos;
+      typedef typename _Clos::value_type _Tp;
+
+      enum { __value = (__rvv_valarray_op<_Oper>::__value
+			&& __rvv_valarray_expr<_Arg>::__value) };
+
+      static typename __rvv_valarray_ops<_Tp>::__vec
+      _S_eval(const _Clos& __c, size_t __i, size_t __vl)
+      {
+	return __rvv_valarray_ops<_Tp>::_S_apply
+	  (_Oper(), __rvv_valarray_expr<_Arg>::_S_eval(__c._M_expr, __i, __vl),
+	   __vl);
+      }
+    };
+
+  template<class _Oper, class _FirstArg, class _SecondArg>
+    struct __rvv_valarray_expr<__detail::_BinBase<_Oper, _FirstArg,
+						  _SecondArg> >
+    {
+      typedef __detail::_BinBase<_Oper, _FirstArg, _SecondArg> _Clos;
+      typedef typename _Clos::value_type _Tp;
+
+      enum { __value = (__rvv_valarray_op<_Oper>::__value
+			&& __rvv_valarray_expr<_FirstArg>::__value
+			&& __rvv_valarray_expr<_SecondArg>::__value) };
+
+      static typename __rvv_valarray_ops<_Tp>::__vec
+      _S_eval(const _Clos& __c, size_t __i, size_t __vl)
+      {
+	return __rvv_valarray_ops<_Tp>::_S_apply
+	  (_Oper(),
+	   __rvv_valarray_expr<_FirstArg>::_S_eval(__c._M_expr1, __i, __vl),
+	   __rvv_valarray_expr<_SecondArg>::_S_eval(__c._M_expr2, __i, __vl),
+	   __vl);
+      }
+    };
+
+  template<class _Oper, class _Clos1>
+    struct __rvv_valarray_expr<__detail::_BinBase1<_Oper, _Clos1> >
+    {
+      typedef __detail::_BinBase1<_Oper, _Clos1> _Clos;
+      typedef typename _Clos::value_type _Tp;
+
+      enum { __value = (__rvv_valarray_op<_Oper>::__value
+			&& __rvv_valarray_ops<_Tp>::__value
+			&& __rvv_valarray_expr<_Clos1>::__value) };
+
+      static typename __rvv_valarray_ops<_Tp>::__vec
+      _S_eval(const _Clos& __c, size_t __i, size_t __vl)
+      {
+	return __rvv_valarray_ops<_Tp>::_S_apply
+	  (_Oper(), __rvv_valarray_ops<_Tp>::_S_splat(__c._M_expr1, __vl),
+	   __rvv_valarray_expr<_Clos1>::_S_eval(__c._M_expr2, __i, __vl),
+	   __vl);
+      }
+    };
+
+  template<class _Oper, class _Clos2>
+    struct __rvv_valarray_expr<__detail::_BinBase2<_Oper, _Clos2> >
+    {
+      typedef __detail::_BinBase2<_Oper, _Clos2> _Clos;
+      typedef typename _Clos::value_type _Tp;
+
+      enum { __value = (__rvv_valarray_op<_Oper>::__value
+			&& __rvv_valarray_ops<_Tp>::__value
+			&& __rvv_valarray_expr<_Clos2>::__value) };
+
+      static typename __rvv_valarray_ops<_Tp>::__vec
+      _S_eval(const _Clos& __c, size_t __i, size_t __vl)
+      {
+	return __rvv_valarray_ops<_Tp>::_S_apply
+	  (_Oper(),
+	   __rvv_valarray_expr<_Clos2>::_S_eval(__c._M_expr1, __i, __vl),
+	   __rvv_valarray_ops<_Tp>::_S_splat(__c._M_expr2, __vl), __vl);
+      }
+    };
+
+  template<class _Oper, template<class, class> class _Meta, class _Dom>
+    struct __rvv_valarray_expr<__detail::_UnClos<_Oper, _Meta, _Dom> >
+    : __rvv_valarray_expr<typename __detail::_UnClos<_Oper, _Meta,
+						     _Dom>::_Base>
+    { };
+
+  template<class _Oper, template<class, class> class _Meta1,
+	   template<class, class> class _Meta2, class _Dom1, class _Dom2>
+    struct __rvv_valarray_expr<__detail::_BinClos<_Oper, _Meta1, _Meta2,
+						  _Dom1, _Dom2> >
+    : __rvv_valarray_expr<typename __detail::_BinClos<_Oper, _Meta1, _Meta2,
+						      _Dom1, _Dom2>::_Base>
+    { };
+
+  template<class _Oper, typename _Tp, class _Arg>
+    struct __rvv_valarray_expr<__rvv_valarray_binary<_Oper, _Tp*, _Arg> >
+    {
+      typedef __rvv_valarray_binary<_Oper, _Tp*, _Arg> _Clos;
+
+      enum { __value = (__rvv_valarray_op<_Oper>::__value
+			&& __rvv_valarray_ops<_Tp>::__value
+			&& __rvv_valarray_expr<_Arg>::__value) };
+
+      static typename __rvv_valarray_ops<_Tp>::__vec
+      _S_eval(const _Clos& __c, size_t __i, size_t __vl)
+      {
+	return __rvv_valarray_ops<_Tp>::_S_apply
+	  (_Oper(), __rvv_valarray_ops<_Tp>::_S_load(__c._M_arg1 + __i, __vl),
+	   __rvv_valarray_expr<_Arg>::_S_eval(__c._M_arg2, __i, __vl), __vl);
+      }
+    };
+
+  template<class _Clos>
+    struct __rvv_valarray_eval<_Clos, true>
+    {
+      template<typename _Tp>
+	static bool
+	_S_copy(const _Clos& __e, size_t __n, _Tp* __a)
+	{
+	  typedef __rvv_valarray_ops<_Tp> _Ops;
+	  for (size_t __i = 0, __vl; __i < __n; __i += __vl)
+	    {
+	      __vl = _Ops::_S_setvl(__n - __i);
+	      _Ops::_S_store(__a + __i,
+			     __rvv_valarray_expr<_Clos>::_S_eval(__e, __i, __vl),
+			     __vl);
+	    }
+	  return true;
+	}
+
+      template<typename _Tp>
+	static bool
+	_S_copy(const _Clos& __e, size_t __n, _Tp* __a, size_t __s)
+	{
+	  typedef __rvv_valarray_ops<_Tp> _Ops;
+	  for (size_t __i = 0, __vl; __i < __n; __i += __vl)
+	    {
+	      __vl = _Ops::_S_setvl(__n - __i);
+	      _Ops::_S_store(__a + __i * __s, __s,
+			     __rvv_valarray_expr<_Clos>::_S_eval(__e, __i, __vl),
+			     __vl);
+	    }
+	  return true;
+	}
+    };
+
+  template<typename _Tp>
+    struct __rvv_valarray<_Tp, true>
+    {
+      typedef __rvv_valarray_ops<_Tp> _Ops;
+
+      static bool
+      _S_fill(_Tp* __a, size_t __n, const _Tp& __t)
+      {
+	for (size_t __i = 0, __vl; __i < __n; __i += __vl)
+	  {
+	    __vl = _Ops::_S_setvl(__n - __i);
+	    _Ops::_S_store(__a + __i, _Ops::_S_splat(__t, __vl), __vl);
+	  }
+	return true;
+      }
+
+      static bool
+      _S_fill(_Tp* __a, size_t __n, size_t __s, const _Tp& __t)
+      {
+	for (size_t __i = 0, __vl; __i < __n; __i += __vl)
+	  {
+	    __vl = _Ops::_S_setvl(__n - __i);
+	    _Ops::_S_store(__a + __i * __s, __s, _Ops::_S_splat(__t, __vl),
+			   __vl);
+	  }
+	return true;
+      }
+
+      // __b[<__n>] = __a[<__n : __s>]
+      static bool
+      _S_copy(const _Tp* __a, size_t __n, size_t __s, _Tp* __b)
+      {
+	for (size_t __i = 0, __vl; __i < __n; __i += __vl)
+	  {
+	    __vl = _Ops::_S_setvl(__n - __i);
+	    _Ops::_S_store(__b + __i, _Ops::_S_load(__a + __i * __s, __s, __vl),
+			   __vl);
+	  }
+	return true;
+      }
+
+      // __b[<__n : __s>] = __a[<__n>]
+      static bool
+      _S_copy(const _Tp* __a, _Tp* __b, size_t __n, size_t __s)
+      {
+	for (size_t __i = 0, __vl; __i < __n; __i += __vl)
+	  {
+	    __vl = _Ops::_S_setvl(__n - __i);
+	    _Ops::_S_store(__b + __i * __s, __s, _Ops::_S_load(__a + __i, __vl),
+			   __vl);
+	  }
+	return true;
+      }
+
+      // __dst[<__n : __s2>] = __src[<__n : __s1>]
+      static bool
+      _S_copy(const _Tp* __src, size_t __n, size_t __s1,
+	      _Tp* __dst, size_t __s2)
+      {
+	for (size_t __i = 0, __vl; __i < __n; __i += __vl)
+	  {
+	    __vl = _Ops::_S_setvl(__n - __i);
+	    _Ops::_S_store(__dst + __i * __s2, __s2,
+			   _Ops::_S_load(__src + __i * __s1, __s1, __vl), __vl);
+	  }
+	return true;
+      }
+
+      // __b[<__n>] = __a[__i[<__n>]]
+      static bool
+      _S_copy(const _Tp* __a, const size_t* __i, _Tp* __b, size_t __n)
+      { return _S_gather(__a, __i, __b, __n, __bool<_Ops::__indexed>()); }
+
+      // __b[__i[<__n>]] = __a[<__n>]
+      static bool
+      _S_copy(const _Tp* __a, size_t __n, _Tp* __b, const size_t* __i)
+      { return _S_scatter(__a, __n, __b, __i, __bool<_Ops::__indexed>()); }
+
+    private:
+      template<bool>
+	struct __bool { };
+
+      static bool
+      _S_gather(const _Tp*, const size_t*, _Tp*, size_t, __bool<false>)
+      { return false; }
+
+      static bool
+      _S_scatter(const _Tp*, size_t, _Tp*, const size_t*, __bool<false>)
+      { return false; }
+
+      static bool
+      _S_gather(const _Tp* __a, const size_t* __i, _Tp* __b, size_t __n,
+		__bool<true>)
+      {
+	for (size_t __j = 0, __vl; __j < __n; __j += __vl)
+	  {
+	    __vl = _Ops::_S_setvl(__n - __j);
+	    _Ops::_S_store(__b + __j,
+			   _Ops::_Indexed::_S_gather(__a, __i + __j, __vl),
+			   __vl);
+	  }
+	return true;
+      }
+
+      // Ordered stores, so that a repeated index keeps the last value.
+      static bool
+      _S_scatter(const _Tp* __a, size_t __n, _Tp* __b, const size_t* __i,
+		 __bool<true>)
+      {
+	for (size_t __j = 0, __vl; __j < __n; __j += __vl)
+	  {
+	    __vl = _Ops::_S_setvl(__n - __j);
+	    _Ops::_Indexed::_S_scatter(__b, __i + __j,
+				       _Ops::_S_load(__a + __j, __vl), __vl);
+	  }
+	return true;
+      }
+    };
+
+#endif // __riscv_vector
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace
+
+#endif /* _VALARRAY_RVV_H */
@@ -402,9 +402,13 @@ __brick_equal(_RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _
     if (__last1 - __first1 != __last2 - __first2)
         return false;
 
+#if _PSTL_RVV_BACKEND
+    return __unseq_backend::__rvv_mismatch(__first1, __last1 - __first1, __first2, __p).first == __last1;
+#else
     return __unseq_backend::__simd_first(__first1, __last1 - __first1, __first2,
                                          __internal::__not_pred<_BinaryPredicate>(__p))
                .first == __last1;
+#endif
 }
 
 template <class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate,
@@ -454,8 +458,12 @@ bool
 __brick_equal(_RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _RandomAccessIterator2 __first2,
               _BinaryPredicate __p, /* is_vector = */ std::true_type) noexcept
 {
+#if _PSTL_RVV_BACKEND
+    return __unseq_backend::__rvv_mismatch(__first1, __last1 - __first1, __first2, __p).first == __last1;
+#else
     return __unseq_backend::__simd_first(__first1, __last1 - __first1, __first2, __not_pred<_BinaryPredicate>(__p))
                .first == __last1;
+#endif
 }
 
 template <class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate,
@@ -499,10 +507,14 @@ _RandomAccessIterator
 __brick_find_if(_RandomAccessIterator __first, _RandomAccessIterator __last, _Predicate __pred,
                 /*is_vector=*/std::true_type) noexcept
 {
+#if _PSTL_RVV_BACKEND
+    return __unseq_backend::__rvv_find_if(__first, __last, __pred);
+#else
     typedef typename std::iterator_traits<_RandomAccessIterator>::difference_type _SizeType;
     return __unseq_backend::__simd_first(
         __first, _SizeType(0), __last - __first,
         [&__pred](_RandomAccessIterator __it, _SizeType __i) { return __pred(__it[__i]); });
+#endif
 }
 
 template <class _ExecutionPolicy, class _ForwardIterator, class _Predicate, class _IsVector>
@@ -1089,7 +1101,11 @@ typename std::iterator_traits<_ForwardIterator>::difference_type
 __brick_count(_ForwardIterator __first, _ForwardIterator __last, _Predicate __pred,
               /* is_vector = */ std::true_type) noexcept
 {
+#if _PSTL_RVV_BACKEND
+    return __unseq_backend::__rvv_count(__first, __last, __pred);
+#else
     return __unseq_backend::__simd_count(__first, __last - __first, __pred);
+#endif
 }
 
 template <class _ForwardIterator, class _Predicate>
@@ -3487,7 +3503,11 @@ __brick_mismatch(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _Forward
                  _ForwardIterator2 __last2, _Predicate __pred, /* __is_vector = */ std::true_type) noexcept
 {
     auto __n = std::min(__last1 - __first1, __last2 - __first2);
+#if _PSTL_RVV_BACKEND
+    return __unseq_backend::__rvv_mismatch(__first1, __n, __first2, __pred);
+#else
     return __unseq_backend::__simd_first(__first1, __n, __first2, __not_pred<_Predicate>(__pred));
+#endif
 }
 
 template <class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _Predicate, class _IsVector>
@@ -44,10 +44,14 @@ __brick_transform_reduce(_ForwardIterator1 __first1, _ForwardIterator1 __last1,
                          _BinaryOperation1 __binary_op1, _BinaryOperation2 __binary_op2,
                          /*is_vector=*/std::true_type) noexcept
 {
+#if _PSTL_RVV_BACKEND
+    return __unseq_backend::__rvv_transform_reduce(__first1, __last1, __first2, __init, __binary_op1, __binary_op2);
+#else
     typedef typename std::iterator_traits<_ForwardIterator1>::difference_type _DifferenceType;
     return __unseq_backend::__simd_transform_reduce(
         __last1 - __first1, __init, __binary_op1,
         [=, &__binary_op2](_DifferenceType __i) { return __binary_op2(__first1[__i], __first2[__i]); });
+#endif
 }
 
 template <class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _Tp, class _BinaryOperation1,
@@ -105,10 +109,14 @@ _Tp
 __brick_transform_reduce(_ForwardIterator __first, _ForwardIterator __last, _Tp __init, _BinaryOperation __binary_op,
                          _UnaryOperation __unary_op, /*is_vector=*/std::true_type) noexcept
 {
+#if _PSTL_RVV_BACKEND
+    return __unseq_backend::__rvv_transform_reduce(__first, __last, __init, __binary_op, __unary_op);
+#else
     typedef typename std::iterator_traits<_ForwardIterator>::difference_type _DifferenceType;
     return __unseq_backend::__simd_transform_reduce(
         __last - __first, __init, __binary_op,
         [=, &__unary_op](_DifferenceType __i) { return __unary_op(__first[__i]); });
+#endif
 }
 
 template <class _ExecutionPolicy, class _ForwardIterator, class _Tp, class _BinaryOperation, class _UnaryOperation,
@@ -64,6 +64,15 @@
 #    define _PSTL_PRAGMA_SIMD_REDUCTION(PRM)
 #endif //Enable SIMD
 
+// Use the RISC-V vector kernels in the unsequenced bricks where they apply
+#if !defined(_PSTL_RVV_BACKEND)
+#    if defined(__riscv_vector)
+#        define _PSTL_RVV_BACKEND 1
+#    else
+#        define _PSTL_RVV_BACKEND 0
+#    endif
+#endif
+
 #if (__INTEL_COMPILER)
 #    define _PSTL_PRAGMA_FORCEINLINE _PSTL_PRAGMA(forceinline)
 #else
@@ -0,0 +1,431 @@
+// -*- C++ -*-
+//===-- unseq_backend_rvv.h -----------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _PSTL_UNSEQ_BACKEND_RVV_H
+#define _PSTL_UNSEQ_BACKEND_RVV_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <riscv_vector.h>
+
+#include "utils.h"
+
+// RISC-V vector kernels for the unsequenced policies.  The generic
+// __simd_* routines only see opaque lambdas, so the bricks for reduce,
+// dot-product transform_reduce, find, count, equal and mismatch first try
+// the __rvv_* dispatchers below.  When the iterators are contiguous, the
+// element type is arithmetic and the operation is one of the library's own
+// function objects, the work is strip-mined with vsetvl at LMUL=4;
+// everything else falls through to the __simd_* routines unchanged.
+namespace __pstl
+{
+namespace __unseq_backend
+{
+
+//! Scalar type the vector kernels operate on for element type _Tp, or void.
+template <std::size_t _Size, bool _Signed>
+struct __rvv_int
+{
+    typedef void type;
+};
+
+template <>
+struct __rvv_int<1, true>
+{
+    typedef std::int8_t type;
+};
+
+template <>
+struct __rvv_int<1, false>
+{
+    typedef std::uint8_t type;
+};
+
+template <>
+struct __rvv_int<2, true>
+{
+    typedef std::int16_t type;
+};
+
+template <>
+struct __rvv_int<2, false>
+{
+    typedef std::uint16_t type;
+};
+
+template <>
+struct __rvv_int<4, true>
+{
+    typedef std::int32_t type;
+};
+
+template <>
+struct __rvv_int<4, false>
+{
+    typedef std::uint32_t type;
+};
+
+template <>
+struct __rvv_int<8, true>
+{
+    typedef std::int64_t type;
+};
+
+template <>
+struct __rvv_int<8, false>
+{
+    typedef std::uint64_t type;
+};
+
+template <typename _Tp, typename = void>
+struct __rvv_element
+{
+    typedef void type;
+};
+
+template <typename _Tp>
+struct __rvv_element<
+    _Tp, typename std::enable_if<std::is_integral<_Tp>::value && !std::is_same<_Tp, bool>::value>::type>
+    : __rvv_int<sizeof(_Tp), std::is_signed<_Tp>::value>
+{
+};
+
+template <>
+struct __rvv_element<float>
+{
+    typedef float type;
+};
+
+template <>
+struct __rvv_element<double>
+{
+    typedef double type;
+};
+
+//! Raw pointer access for iterators over contiguous storage.
+template <typename _Iterator>
+struct __rvv_contiguous
+{
+    static constexpr bool value = false;
+};
+
+template <typename _Tp>
+struct __rvv_contiguous<_Tp*>
+{
+    static constexpr bool value = true;
+
+    static _Tp*
+    __get(_Tp* __it) noexcept
+    {
+        return __it;
+    }
+};
+
+template <typename _Tp, typename _Container>
+struct __rvv_contiguous<__gnu_cxx::__normal_iterator<_Tp*, _Container>>
+{
+    static constexpr bool value = true;
+
+    static _Tp*
+    __get(__gnu_cxx::__normal_iterator<_Tp*, _Container> __it) noexcept
+    {
+        return __it.base();
+    }
+};
+
+template <typename _Iterator>
+using __rvv_value_t = typename std::iterator_traits<_Iterator>::value_type;
+
+//! Kernel element type for _Iterator, or void if the kernels do not apply.
+template <typename _Iterator>
+using __rvv_iter_element_t =
+    typename std::conditional<__rvv_contiguous<_Iterator>::value,
+                              typename __rvv_element<__rvv_value_t<_Iterator>>::type, void>::type;
+
+template <typename _Iterator>
+const __rvv_iter_element_t<_Iterator>*
+__rvv_data(_Iterator __it) noexcept
+{
+    return reinterpret_cast<const __rvv_iter_element_t<_Iterator>*>(__rvv_contiguous<_Iterator>::__get(__it));
+}
+
+template <typename _Operation, typename _Tp, template <typename> class _Functor>
+struct __rvv_is_functor
+    : std::integral_constant<bool, std::is_same<_Operation, _Functor<_Tp>>::value ||
+                                       std::is_same<_Operation, _Functor<void>>::value>
+{
+};
+
+// The kernels, one set per element type.  Accumulators always run at VLMAX
+// because tail elements are not preserved across a shorter vl, so the last
+// partial strip is reduced separately.
+#define _PSTL_RVV_KERNELS(_Tp, _Vt, _Sfx, _Sew, _Mlen, _Add, _Mul, _Macc, _Redsum, _Splat, _Extract, _Eq, _Ne)     \
+    inline _Tp __rvv_reduce_plus(const _Tp* __p, std::size_t __n, _Tp __init) noexcept                              \
+    {                                                                                                                \
+        const std::size_t __vlmax = vsetvlmax_e##_Sew##m4();                                                         \
+        v##_Vt##m1_t __sum = v##_Splat##_##_Sfx##m1(__init, 1);                                                      \
+        if (__n >= __vlmax)                                                                                          \
+        {                                                                                                            \
+            v##_Vt##m4_t __acc = vle##_Sew##_v_##_Sfx##m4(__p, __vlmax);                                             \
+            std::size_t __i = __vlmax;                                                                               \
+            for (; __n - __i >= __vlmax; __i += __vlmax)                                                             \
+                __acc = v##_Add##_vv_##_Sfx##m4(__acc, vle##_Sew##_v_##_Sfx##m4(__p + __i, __vlmax), __vlmax);       \
+            __sum = v##_Redsum##_vs_##_Sfx##m4_##_Sfx##m1(__sum, __acc, __sum, __vlmax);                             \
+            __p += __i;                                                                                              \
+            __n -= __i;                                                                                              \
+        }                                                                                                            \
+        if (__n != 0)                                                                                                \
+        {                                                                                                            \
+            const std::size_t __vl = vsetvl_e##_Sew##m4(__n);                                                        \
+            __sum = v##_Redsum##_vs_##_Sfx##m4_##_Sfx##m1(__sum, vle##_Sew##_v_##_Sfx##m4(__p, __vl), __sum, __vl);  \
+        }                                                                                                            \
+        return v##_Extract##_##_Sfx##m1_##_Sfx(__sum);                                                               \
+    }                                                                                                                \
+                                                                                                                     \
+    inline _Tp __rvv_dot(const _Tp* __a, const _Tp* __b, std::size_t __n, _Tp __init) noexcept                       \
+    {                                                                                                                \
+        const std::size_t __vlmax = vsetvlmax_e##_Sew##m4();                                                         \
+        v##_Vt##m1_t __sum = v##_Splat##_##_Sfx##m1(__init, 1);                                                      \
+        if (__n >= __vlmax)                                                                                          \
+        {                                                                                                            \
+            v##_Vt##m4_t __acc = v##_Mul##_vv_##_Sfx##m4(vle##_Sew##_v_##_Sfx##m4(__a, __vlmax),                     \
+                                                         vle##_Sew##_v_##_Sfx##m4(__b, __vlmax), __vlmax);           \
+            std::size_t __i = __vlmax;                                                                               \
+            for (; __n - __i >= __vlmax; __i += __vlmax)                                                             \
+                __acc = v##_Macc##_vv_##_Sfx##m4(__acc, vle##_Sew##_v_##_Sfx##m4(__a + __i, __vlmax),                \
+                                                 vle##_Sew##_v_##_Sfx##m4(__b + __i, __vlmax), __vlmax);             \
+            __sum = v##_Redsum##_vs_##_Sfx##m4_##_Sfx##m1(__sum, __acc, __sum, __vlmax);                             \
+            __a += __i;                                                                                              \
+            __b += __i;                                                                                              \
+            __n -= __i;                                                                                              \
+        }                                                                                                            \
+        if (__n != 0)                                                                                                \
+        {                                                                                                            \
+            const std::size_t __vl = vsetvl_e##_Sew##m4(__n);                                                        \
+            v##_Vt##m4_t __prod = v##_Mul##_vv_##_Sfx##m4(vle##_Sew##_v_##_Sfx##m4(__a, __vl),                       \
+                                                          vle##_Sew##_v_##_Sfx##m4(__b, __vl), __vl);                \
+            __sum = v##_Redsum##_vs_##_Sfx##m4_##_Sfx##m1(__sum, __prod, __sum, __vl);                               \
+        }                                                                                                            \
+        return v##_Extract##_##_Sfx##m1_##_Sfx(__sum);                                                               \
+    }                                                                                                                \
+                                                                                                                     \
+    inline std::size_t __rvv_find_equal(const _Tp* __p, std::size_t __n, _Tp __value) noexcept                       \
+    {                                                                                                                \
+        for (std::size_t __i = 0, __vl; __i < __n; __i += __vl)                                                      \
+        {                                                                                                            \
+            __vl = vsetvl_e##_Sew##m4(__n - __i);                                                                    \
+            const long __k = vfirst_m_b##_Mlen(                                                                      \
+                v##_Eq##_##_Sfx##m4_b##_Mlen(vle##_Sew##_v_##_Sfx##m4(__p + __i, __vl), __value, __vl), __vl);       \
+            if (__k >= 0)                                                                                            \
+                return __i + __k;                                                                                    \
+        }                                                                                                            \
+        return __n;                                                                                                  \
+    }                                                                                                                \
+                                                                                                                     \
+    inline std::size_t __rvv_count_equal(const _Tp* __p, std::size_t __n, _Tp __value) noexcept                      \
+    {                                                                                                                \
+        std::size_t __count = 0;                                                                                     \
+        for (std::size_t __i = 0, __vl; __i < __n; __i += __vl)                                                      \
+        {                                                                                                            \
+            __vl = vsetvl_e##_Sew##m4(__n - __i);                                                                    \
+            __count += vcpop_m_b##_Mlen(                                                                             \
+                v##_Eq##_##_Sfx##m4_b##_Mlen(vle##_Sew##_v_##_Sfx##m4(__p + __i, __vl), __value, __vl), __vl);       \
+        }                                                                                                            \
+        return __count;                                                                                              \
+    }                                                                                                                \
+                                                                                                                     \
+    inline std::size_t __rvv_first_mismatch(const _Tp* __a, const _Tp* __b, std::size_t __n) noexcept                     \
+    {                                                                                                                \
+        for (std::size_t __i = 0, __vl; __i < __n; __i += __vl)                                                      \
+        {                                                                                                            \
+            __vl = vsetvl_e##_Sew##m4(__n - __i);                                                                    \
+            const long __k = vfirst_m_b##_Mlen(v##_Ne##_vv_##_Sfx##m4_b##_Mlen(                                      \
+                                                   vle##_Sew##_v_##_Sfx##m4(__a + __i, __vl),                        \
+                                                   vle##_Sew##_v_##_Sfx##m4(__b + __i, __vl), __vl),                 \
+                                               __vl);                                                                \
+            if (__k >= 0)                                                                                            \
+                return __i + __k;                                                                                    \
+        }                                                                                                            \
+        return __n;                                                                                                  \
+    }
+
+#define _PSTL_RVV_INT_KERNELS(_Tp, _Vt, _Sfx, _Sew, _Mlen)                                                          \
+    _PSTL_RVV_KERNELS(_Tp, _Vt, _Sfx, _Sew, _Mlen, add, mul, macc, redsum, mv_v_x, mv_x_s, mseq_vx, msne)
+
+#define _PSTL_RVV_FLOAT_KERNELS(_Tp, _Vt, _Sfx, _Sew, _Mlen)                                                        \
+    _PSTL_RVV_KERNELS(_Tp, _Vt, _Sfx, _Sew, _Mlen, fadd, fmul, fmacc, fredusum, fmv_v_f, fmv_f_s, mfeq_vf, mfne)
+
+_PSTL_RVV_INT_KERNELS(std::int8_t, int8, i8, 8, 2)
+_PSTL_RVV_INT_KERNELS(std::uint8_t, uint8, u8, 8, 2)
+_PSTL_RVV_INT_KERNELS(std::int16_t, int16, i16, 16, 4)
+_PSTL_RVV_INT_KERNELS(std::uint16_t, uint16, u16, 16, 4)
+_PSTL_RVV_INT_KERNELS(std::int32_t, int32, i32, 32, 8)
+_PSTL_RVV_INT_KERNELS(std::uint32_t, uint32, u32, 32, 8)
+_PSTL_RVV_INT_KERNELS(std::int64_t, int64, i64, 64, 16)
+_PSTL_RVV_INT_KERNELS(std::uint64_t, uint64, u64, 64, 16)
+_PSTL_RVV_FLOAT_KERNELS(float, float32, f32, 32, 8)
+_PSTL_RVV_FLOAT_KERNELS(double, float64, f64, 64, 16)
+
+#undef _PSTL_RVV_FLOAT_KERNELS
+#undef _PSTL_RVV_INT_KERNELS
+#undef _PSTL_RVV_KERNELS
+
+//------------------------------------------------------------------------
+// reduce: transform_reduce(first, last, init, plus, __no_op)
+//------------------------------------------------------------------------
+
+template <typename _Iterator, typename _Tp, typename _BinaryOperation, typename _UnaryOperation>
+using __rvv_reduce_enabled = std::integral_constant<
+    bool, !std::is_void<__rvv_iter_element_t<_Iterator>>::value && std::is_same<_Tp, __rvv_value_t<_Iterator>>::value &&
+              __rvv_is_functor<_BinaryOperation, _Tp, std::plus>::value &&
+              std::is_same<_UnaryOperation, __internal::__no_op>::value>;
+
+template <typename _Iterator, typename _Tp, typename _BinaryOperation, typename _UnaryOperation>
+typename std::enable_if<__rvv_reduce_enabled<_Iterator, _Tp, _BinaryOperation, _UnaryOperation>::value, _Tp>::type
+__rvv_transform_reduce(_Iterator __first, _Iterator __last, _Tp __init, _BinaryOperation, _UnaryOperation) noexcept
+{
+    typedef __rvv_iter_element_t<_Iterator> _Ep;
+    return _Tp(__rvv_reduce_plus(__rvv_data(__first), __last - __first, _Ep(__init)));
+}
+
+template <typename _Iterator, typename _Tp, typename _BinaryOperation, typename _UnaryOperation>
+typename std::enable_if<!__rvv_reduce_enabled<_Iterator, _Tp, _BinaryOperation, _UnaryOperation>::value, _Tp>::type
+__rvv_transform_reduce(_Iterator __first, _Iterator __last, _Tp __init, _BinaryOperation __binary_op,
+                       _UnaryOperation __unary_op) noexcept
+{
+    typedef typename std::iterator_traits<_Iterator>::difference_type _DifferenceType;
+    return __simd_transform_reduce(__last - __first, __init, __binary_op,
+                                   [=, &__unary_op](_DifferenceType __i) { return __unary_op(__first[__i]); });
+}
+
+//------------------------------------------------------------------------
+// dot product: transform_reduce(first1, last1, first2, init, plus, multiplies)
+//------------------------------------------------------------------------
+
+template <typename _Iterator1, typename _Iterator2, typename _Tp, typename _BinaryOperation1,
+          typename _BinaryOperation2>
+using __rvv_dot_enabled = std::integral_constant<
+    bool, !std::is_void<__rvv_iter_element_t<_Iterator1>>::value &&
+              std::is_same<__rvv_iter_element_t<_Iterator1>, __rvv_iter_element_t<_Iterator2>>::value &&
+              std::is_same<_Tp, __rvv_value_t<_Iterator1>>::value &&
+              std::is_same<_Tp, __rvv_value_t<_Iterator2>>::value &&
+              __rvv_is_functor<_BinaryOperation1, _Tp, std::plus>::value &&
+              __rvv_is_functor<_BinaryOperation2, _Tp, std::multiplies>::value>;
+
+template <typename _Iterator1, typename _Iterator2, typename _Tp, typename _BinaryOperation1,
+          typename _BinaryOperation2>
+typename std::enable_if<
+    __rvv_dot_enabled<_Iterator1, _Iterator2, _Tp, _BinaryOperation1, _BinaryOperation2>::value, _Tp>::type
+__rvv_transform_reduce(_Iterator1 __first1, _Iterator1 __last1, _Iterator2 __first2, _Tp __init, _BinaryOperation1,
+                       _BinaryOperation2) noexcept
+{
+    typedef __rvv_iter_element_t<_Iterator1> _Ep;
+    return _Tp(__rvv_dot(__rvv_data(__first1), __rvv_data(__first2), __last1 - __first1, _Ep(__init)));
+}
+
+template <typename _Iterator1, typename _Iterator2, typename _Tp, typename _BinaryOperation1,
+          typename _BinaryOperation2>
+typename std::enable_if<
+    !__rvv_dot_enabled<_Iterator1, _Iterator2, _Tp, _BinaryOperation1, _BinaryOperation2>::value, _Tp>::type
+__rvv_transform_reduce(_Iterator1 __first1, _Iterator1 __last1, _Iterator2 __first2, _Tp __init,
+                       _BinaryOperation1 __binary_op1, _BinaryOperation2 __binary_op2) noexcept
+{
+    typedef typename std::iterator_traits<_Iterator1>::difference_type _DifferenceType;
+    return __simd_transform_reduce(
+        __last1 - __first1, __init, __binary_op1,
+        [=, &__binary_op2](_DifferenceType __i) { return __binary_op2(__first1[__i], __first2[__i]); });
+}
+
+//------------------------------------------------------------------------
+// find / count with __equal_value
+//------------------------------------------------------------------------
+
+template <typename _Iterator, typename _Predicate>
+struct __rvv_equal_value_enabled : std::false_type
+{
+};
+
+template <typename _Iterator, typename _Tp>
+struct __rvv_equal_value_enabled<_Iterator, __internal::__equal_value<_Tp>>
+    : std::integral_constant<bool, !std::is_void<__rvv_iter_element_t<_Iterator>>::value &&
+                                       std::is_same<typename std::remove_cv<_Tp>::type,
+                                                    __rvv_value_t<_Iterator>>::value>
+{
+};
+
+template <typename _Iterator, typename _Predicate>
+typename std::enable_if<__rvv_equal_value_enabled<_Iterator, _Predicate>::value, _Iterator>::type
+__rvv_find_if(_Iterator __first, _Iterator __last, _Predicate __pred) noexcept
+{
+    typedef __rvv_iter_element_t<_Iterator> _Ep;
+    return __first + __rvv_find_equal(__rvv_data(__first), __last - __first, _Ep(__pred.__get_value()));
+}
+
+template <typename _Iterator, typename _Predicate>
+typename std::enable_if<!__rvv_equal_value_enabled<_Iterator, _Predicate>::value, _Iterator>::type
+__rvv_find_if(_Iterator __first, _Iterator __last, _Predicate __pred) noexcept
+{
+    typedef typename std::iterator_traits<_Iterator>::difference_type _SizeType;
+    return __simd_first(__first, _SizeType(0), __last - __first,
+                        [&__pred](_Iterator __it, _SizeType __i) { return __pred(__it[__i]); });
+}
+
+template <typename _Iterator, typename _Predicate>
+typename std::enable_if<__rvv_equal_value_enabled<_Iterator, _Predicate>::value,
+                        typename std::iterator_traits<_Iterator>::difference_type>::type
+__rvv_count(_Iterator __first, _Iterator __last, _Predicate __pred) noexcept
+{
+    typedef __rvv_iter_element_t<_Iterator> _Ep;
+    return __rvv_count_equal(__rvv_data(__first), __last - __first, _Ep(__pred.__get_value()));
+}
+
+template <typename _Iterator, typename _Predicate>
+typename std::enable_if<!__rvv_equal_value_enabled<_Iterator, _Predicate>::value,
+                        typename std::iterator_traits<_Iterator>::difference_type>::type
+__rvv_count(_Iterator __first, _Iterator __last, _Predicate __pred) noexcept
+{
+    return __simd_count(__first, __last - __first, __pred);
+}
+
+//------------------------------------------------------------------------
+// equal / mismatch with __pstl_equal
+//------------------------------------------------------------------------
+
+template <typename _Iterator1, typename _Iterator2, typename _BinaryPredicate>
+using __rvv_mismatch_enabled = std::integral_constant<
+    bool, !std::is_void<__rvv_iter_element_t<_Iterator1>>::value &&
+              std::is_same<__rvv_value_t<_Iterator1>, __rvv_value_t<_Iterator2>>::value &&
+              __rvv_contiguous<_Iterator2>::value && std::is_same<_BinaryPredicate, __internal::__pstl_equal>::value>;
+
+template <typename _Iterator1, typename _DifferenceType, typename _Iterator2, typename _BinaryPredicate>
+typename std::enable_if<__rvv_mismatch_enabled<_Iterator1, _Iterator2, _BinaryPredicate>::value,
+                        std::pair<_Iterator1, _Iterator2>>::type
+__rvv_mismatch(_Iterator1 __first1, _DifferenceType __n, _Iterator2 __first2, _BinaryPredicate) noexcept
+{
+    const _DifferenceType __i = __rvv_first_mismatch(__rvv_data(__first1), __rvv_data(__first2), __n);
+    return std::make_pair(__first1 + __i, __first2 + __i);
+}
+
+template <typename _Iterator1, typename _DifferenceType, typename _Iterator2, typename _BinaryPredicate>
+typename std::enable_if<!__rvv_mismatch_enabled<_Iterator1, _Iterator2, _BinaryPredicate>::value,
+                        std::pair<_Iterator1, _Iterator2>>::type
+__rvv_mismatch(_Iterator1 __first1, _DifferenceType __n, _Iterator2 __first2, _BinaryPredicate __pred) noexcept
+{
+    return __simd_first(__first1, __n, __first2, __internal::__not_pred<_BinaryPredicate>(__pred));
+}
+
+} // namespace __unseq_backend
+} // namespace __pstl
+
+#endif /* _PSTL_UNSEQ_BACKEND_RVV_H */
@@ -852,4 +852,8 @@ __simd_remove_if(_RandomAccessIterator __first, _DifferenceType __n, _UnaryPredi
 } // namespace __unseq_backend
 } // namespace __pstl
 
+#if _PSTL_RVV_BACKEND
+#    include "unseq_backend_rvv.h"
+#endif
+
 #endif /* _PSTL_UNSEQ_BACKEND_SIMD_H */
@@ -1,4 +1,4 @@
-// Optimizations for random number extensions, generic version -*- C++ -*-
+// Optimizations for random number extensions, RISC-V version -*- C++ -*-
 
 // Copyright (C) 2012-2020 Free Software Foundation, Inc.
 //
@@ -32,7 +32,177 @@
 
 #pragma GCC system_header
 
+#ifdef __riscv_vector
+#include <riscv_vector.h>
 
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
 
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  namespace {
+
+    /* The SFMT recursion is
+	 r[i] = a ^ (a << sl2) ^ ((b >> sr1) & msk) ^ (c >> sr2) ^ (d << sl1)
+       with a = w[i], b = w[i + pos1], c = r[i - 2] and d = r[i - 1].
+       Only the last two terms chain one block to the next, so the
+       others are computed for a run of blocks in vector registers and
+       the chain is then followed with 64-bit scalar arithmetic.  */
+
+    // __out[<__n>] = a ^ (a << __sl2) ^ ((b >> __sr1) & msk) for the
+    // blocks of __a and __b, __n counted in 32-bit words.
+    template<size_t __sl2, size_t __sr1,
+	     uint32_t __msk1, uint32_t __msk2,
+	     uint32_t __msk3, uint32_t __msk4>
+      inline void __rvv_linear(uint32_t *__out, const uint32_t *__a,
+			       const uint32_t *__b, size_t __n)
+      {
+	static const uint32_t __msk[4] = { __msk1, __msk2, __msk3, __msk4 };
+	const size_t __vlmax = vsetvlmax_e32m4();
+	const vuint32m4_t __mskv
+	  = vrgather_vv_u32m4(vle32_v_u32m4(__msk, 4),
+			      vand_vx_u32m4(vid_v_u32m4(__vlmax), 3, __vlmax),
+			      __vlmax);
+	// All ones in the high doubleword of each block.
+	const vuint64m4_t __odd
+	  = vrsub_vx_u64m4(vand_vx_u64m4(vid_v_u64m4(__vlmax / 2), 1,
+					 __vlmax / 2), 0, __vlmax / 2);
+
+	for (size_t __vl; __n > 0;
+	     __n -= __vl, __out += __vl, __a += __vl, __b += __vl)
+	  {
+	    // Whole blocks only, so that lane 0 starts a block.
+	    __vl = vsetvl_e32m4(__n) & ~size_t(3);
+	    const size_t __vl64 = __vl / 2;
+
+	    vuint32m4_t __x = vle32_v_u32m4(__a, __vl);
+	    vuint64m4_t __x64 = vreinterpret_v_u32m4_u64m4(__x);
+	    vuint64m4_t __sh;
+	    if (__sl2 == 0)
+	      __sh = __x64;
+	    else if (__sl2 < 8)
+	      __sh = vor_vv_u64m4(vsll_vx_u64m4(__x64, __sl2 * 8, __vl64),
+				  vand_vv_u64m4(vslide1up_vx_u64m4(
+				    vsrl_vx_u64m4(__x64, 64 - __sl2 * 8,
+						  __vl64), 0, __vl64),
+						__odd, __vl64), __vl64);
+	    else
+	      __sh = vand_vv_u64m4(vslide1up_vx_u64m4(
+				     vsll_vx_u64m4(__x64, __sl2 * 8 - 64,
+						   __vl64), 0, __vl64),
+				   __odd, __vl64);
+
+	    __x = vxor_vv_u32m4(__x, vreinterpret_v_u64m4_u32m4(__sh), __vl);
+	    __x = vxor_vv_u32m4(__x,
+				vand_vv_u32m4(vsrl_vx_u32m4(vle32_v_u32m4(__b,
+									  __vl),
+							    __sr1, __vl),
+					      __mskv, __vl), __vl);
+	    vse32_v_u32m4(__out, __x, __vl);
+	  }
+      }
+
+
+    // __r = __t ^ (__c >> __sr2) ^ (__d << __sl1), one block.
+    template<size_t __sl1, size_t __sr2>
+      inline void __rvv_chain(uint32_t *__r, const uint32_t *__t,
+			      const uint32_t *__c, const uint32_t *__d)
+      {
+	const uint64_t __mask = ((static_cast<uint64_t>(~UINT32_C(0) << __sl1)
+				  << 32) | (~UINT32_C(0) << __sl1));
+	uint64_t __tl, __th, __cl, __ch, __dl, __dh;
+
+	__builtin_memcpy(&__tl, __t, 8);
+	__builtin_memcpy(&__th, __t + 2, 8);
+	__builtin_memcpy(&__cl, __c, 8);
+	__builtin_memcpy(&__ch, __c + 2, 8);
+	__builtin_memcpy(&__dl, __d, 8);
+	__builtin_memcpy(&__dh, __d + 2, 8);
+
+	if (__sr2 == 0)
+	  ;
+	else if (__sr2 < 8)
+	  {
+	    __cl = (__cl >> (__sr2 * 8)) | (__ch << (64 - __sr2 * 8));
+	    __ch >>= __sr2 * 8;
+	  }
+	else
+	  {
+	    __cl = __ch >> (__sr2 * 8 - 64);
+	    __ch = 0;
+	  }
+
+	__tl ^= __cl ^ ((__dl << __sl1) & __mask);
+	__th ^= __ch ^ ((__dh << __sl1) & __mask);
+	__builtin_memcpy(__r, &__tl, 8);
+	__builtin_memcpy(__r + 2, &__th, 8);
+      }
+
+  }
+
+
+#define _GLIBCXX_OPT_HAVE_RANDOM_SFMT_GEN_READ	1
+  template<typename _UIntType, size_t __m,
+	   size_t __pos1, size_t __sl1, size_t __sl2,
+	   size_t __sr1, size_t __sr2,
+	   uint32_t __msk1, uint32_t __msk2,
+	   uint32_t __msk3, uint32_t __msk4,
+	   uint32_t __parity1, uint32_t __parity2,
+	   uint32_t __parity3, uint32_t __parity4>
+    void simd_fast_mersenne_twister_engine<_UIntType, __m,
+					   __pos1, __sl1, __sl2, __sr1, __sr2,
+					   __msk1, __msk2, __msk3, __msk4,
+					   __parity1, __parity2, __parity3,
+					   __parity4>::
+    _M_gen_rand(void)
+    {
+      // A run must not pass the block where w[i + pos1] wraps round,
+      // and when it has wrapped it must only read blocks of earlier
+      // runs, so runs are at most _M_nstate - __pos1 blocks long.
+      const size_t __wrap = _M_nstate - __pos1;
+      const size_t __run = __wrap < 32 ? __wrap : 32;
+      uint32_t __t[4 * 32];
+      const uint32_t *__r1 = &_M_state32[_M_nstate32 - 8];
+      const uint32_t *__r2 = &_M_state32[_M_nstate32 - 4];
+
+      for (size_t __i = 0; __i < _M_nstate; )
+	{
+	  size_t __end = __i + __run;
+	  const uint32_t *__b;
+	  if (__i < __wrap)
+	    {
+	      if (__end > __wrap)
+		__end = __wrap;
+	      __b = &_M_state32[4 * (__i + __pos1)];
+	    }
+	  else
+	    {
+	      if (__end > _M_nstate)
+		__end = _M_nstate;
+	      __b = &_M_state32[4 * (__i - __wrap)];
+	    }
+
+	  __rvv_linear<__sl2, __sr1, __msk1, __msk2, __msk3, __msk4>
+	    (__t, &_M_state32[4 * __i], __b, 4 * (__end - __i));
+
+	  for (const uint32_t *__tp = __t; __i < __end; ++__i, __tp += 4)
+	    {
+	      __rvv_chain<__sl1, __sr2>(&_M_state32[4 * __i], __tp,
+					__r1, __r2);
+	      __r1 = __r2;
+	      __r2 = &_M_state32[4 * __i];
+	    }
+	}
+
+      _M_pos = 0;
+    }
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace __gnu_cxx
+
+#endif // __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+
+#endif // __riscv_vector
 
 #endif // _EXT_OPT_RANDOM_H
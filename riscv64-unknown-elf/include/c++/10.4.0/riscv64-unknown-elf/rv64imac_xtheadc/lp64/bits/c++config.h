@@ -704,7 +704,7 @@ namespace std
 /* #undef _GLIBCXX_HAVE_ACOSL */
 
 /* Define to 1 if you have the `aligned_alloc' function. */
-/* #undef _GLIBCXX_HAVE_ALIGNED_ALLOC */
+#define _GLIBCXX_HAVE_ALIGNED_ALLOC 1
 
 /* Define to 1 if you have the <arpa/inet.h> header file. */
 /* #undef _GLIBCXX_HAVE_ARPA_INET_H */
@@ -986,7 +986,7 @@ namespace std
 /* #undef _GLIBCXX_HAVE_POLL_H */
 
 /* Define to 1 if you have the `posix_memalign' function. */
-/* #undef _GLIBCXX_HAVE_POSIX_MEMALIGN */
+#define _GLIBCXX_HAVE_POSIX_MEMALIGN 1
 
 /* Define to 1 if you have the `powf' function. */
 #define _GLIBCXX_HAVE_POWF 1
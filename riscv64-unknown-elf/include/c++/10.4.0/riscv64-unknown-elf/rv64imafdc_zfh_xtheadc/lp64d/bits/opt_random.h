@@ -1,4 +1,4 @@
-// Optimizations for random number handling, generic version -*- C++ -*-
+// Optimizations for random number handling, RISC-V version -*- C++ -*-
 
 // Copyright (C) 2012-2020 Free Software Foundation, Inc.
 //
@@ -32,7 +32,336 @@
 
 #pragma GCC system_header
 
+#ifdef __riscv_vector
+#include <riscv_vector.h>
 
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
 
+#define _GLIBCXX_OPT_HAVE_RANDOM_MT_GEN_RAND 1
+
+  namespace __detail
+  {
+    // The first __n - 1 steps of mersenne_twister_engine::_M_gen_rand,
+    // returning how many were done.  Step __k reads _M_x[__k + __m],
+    // which is still to be twisted, or _M_x[__k + __m - __n], which was
+    // twisted __n - __m steps earlier, so strips of up to __n - __m
+    // words have no dependence between their lanes.
+    template<typename _UIntType, size_t = sizeof(_UIntType)>
+      struct _Mt_twist
+      {
+	static size_t
+	_S_do_it(_UIntType*, size_t, size_t, _UIntType, _UIntType)
+	{ return 0; }
+      };
+
+#define _GLIBCXX_RVV_MT_TWIST(_Size, _Elt, _Sew)			\
+    template<typename _UIntType>					\
+      struct _Mt_twist<_UIntType, _Size>				\
+      {									\
+	static void							\
+	_S_strip(_Elt* __x, const _Elt* __src, size_t __len,		\
+		 size_t __max, _Elt __upper, _Elt __a)			\
+	{								\
+	  for (size_t __vl; __len > 0;					\
+	       __len -= __vl, __x += __vl, __src += __vl)		\
+	    {								\
+	      __vl = vsetvl_e##_Sew##m4(__len < __max ? __len : __max);	\
+	      vuint##_Sew##m4_t __y						\
+		= vor_vv_u##_Sew##m4(					\
+		    vand_vx_u##_Sew##m4(vle##_Sew##_v_u##_Sew##m4(__x, __vl), \
+					__upper, __vl),			\
+		    vand_vx_u##_Sew##m4(vle##_Sew##_v_u##_Sew##m4(__x + 1,	\
+								  __vl), \
+					~__upper, __vl), __vl);		\
+	      vuint##_Sew##m4_t __mag					\
+		= vand_vx_u##_Sew##m4(					\
+		    vrsub_vx_u##_Sew##m4(vand_vx_u##_Sew##m4(__y, 1, __vl), \
+					 0, __vl), __a, __vl);		\
+	      __y = vxor_vv_u##_Sew##m4(vsrl_vx_u##_Sew##m4(__y, 1, __vl), \
+					__mag, __vl);			\
+	      vse##_Sew##_v_u##_Sew##m4(__x,				\
+		vxor_vv_u##_Sew##m4(vle##_Sew##_v_u##_Sew##m4(__src, __vl),	\
+				    __y, __vl), __vl);			\
+	    }								\
+	}								\
+									\
+	static size_t							\
+	_S_do_it(_UIntType* __x, size_t __n, size_t __m,		\
+		 _UIntType __upper, _UIntType __a)			\
+	{								\
+	  _Elt* __p = reinterpret_cast<_Elt*>(__x);			\
+	  _S_strip(__p, __p + __m, __n - __m, __n, __upper, __a);	\
+	  _S_strip(__p + (__n - __m), __p, __m - 1,			\
+		   __n == __m ? __n : __n - __m, __upper, __a);		\
+	  return __n - 1;						\
+	}								\
+      };
+
+    _GLIBCXX_RVV_MT_TWIST(4, uint32_t, 32)
+    _GLIBCXX_RVV_MT_TWIST(8, uint64_t, 64)
+
+#undef _GLIBCXX_RVV_MT_TWIST
+
+    // The number of bits of an engine producing every value in
+    // [0, 2^32) or [0, 2^64), and 0 for any other engine.
+    template<typename _UniformRandomNumberGenerator>
+      struct _Rvv_urng_bits
+      {
+	static constexpr int __value
+	  = (_UniformRandomNumberGenerator::min() != 0 ? 0
+	     : _UniformRandomNumberGenerator::max() == 0xffffffffULL ? 32
+	     : _UniformRandomNumberGenerator::max() == ~0ULL ? 64 : 0);
+      };
+
+    // generate_canonical<_RealType, digits> a strip at a time, for an
+    // engine of _Bits bits.  The engine is called in the same order as
+    // by the scalar code, and each value is scaled by __mul and offset
+    // by __add in the way the distributions do it.
+    template<typename _RealType, int _Bits>
+      struct _Rvv_canonical
+      {
+	enum { __value = 0 };
+
+	template<typename _UniformRandomNumberGenerator>
+	  static void
+	  _S_fill(_RealType*, size_t, _UniformRandomNumberGenerator&,
+		  _RealType, _RealType)
+	  { }
+      };
+
+    template<typename _RealType, typename _Raw, typename _Derived>
+      struct _Rvv_canonical_base
+      {
+	enum { __value = 1 };
+
+	template<typename _UniformRandomNumberGenerator>
+	  static void
+	  _S_fill(_RealType* __f, size_t __n,
+		  _UniformRandomNumberGenerator& __urng,
+		  _RealType __mul, _RealType __add)
+	  {
+	    _Raw __u[64];
+
+	    while (__n > 0)
+	      {
+		const size_t __c = __n < 64 ? __n : 64;
+		for (size_t __i = 0; __i < __c; ++__i)
+		  __u[__i] = _Derived::_S_draw(__urng);
+		_Derived::_S_convert(__f, __u, __c, __mul, __add);
+		__f += __c;
+		__n -= __c;
+	      }
+	  }
+      };
+
+    // Two 32-bit draws per double, the first in the low half.
+    template<>
+      struct _Rvv_canonical<double, 32>
+      : _Rvv_canonical_base<double, uint64_t, _Rvv_canonical<double, 32> >
+      {
+	template<typename _UniformRandomNumberGenerator>
+	  static uint64_t
+	  _S_draw(_UniformRandomNumberGenerator& __urng)
+	  {
+	    const uint64_t __lo = __urng();
+	    return __lo | (uint64_t(__urng()) << 32);
+	  }
+
+	static void
+	_S_convert(double* __f, const uint64_t* __u, size_t __n,
+		   double __mul, double __add)
+	{
+	  const double __one = 1.0 - numeric_limits<double>::epsilon() / 2;
+	  for (size_t __vl; __n > 0; __n -= __vl, __u += __vl, __f += __vl)
+	    {
+	      __vl = vsetvl_e64m4(__n);
+	      vuint64m4_t __v = vle64_v_u64m4(__u, __vl);
+	      vfloat64m4_t __d
+		= vfadd_vv_f64m4(
+		    vfcvt_f_xu_v_f64m4(vand_vx_u64m4(__v, 0xffffffffULL,
+						     __vl), __vl),
+		    vfmul_vf_f64m4(vfcvt_f_xu_v_f64m4(vsrl_vx_u64m4(__v, 32,
+								    __vl),
+						      __vl),
+				   4294967296.0, __vl), __vl);
+	      __d = vfmin_vf_f64m4(vfmul_vf_f64m4(__d,
+						  1.0 / 18446744073709551616.0,
+						  __vl), __one, __vl);
+	      __d = vfadd_vf_f64m4(vfmul_vf_f64m4(__d, __mul, __vl),
+				   __add, __vl);
+	      vse64_v_f64m4(__f, __d, __vl);
+	    }
+	}
+      };
+
+    template<>
+      struct _Rvv_canonical<double, 64>
+      : _Rvv_canonical_base<double, uint64_t, _Rvv_canonical<double, 64> >
+      {
+	template<typename _UniformRandomNumberGenerator>
+	  static uint64_t
+	  _S_draw(_UniformRandomNumberGenerator& __urng)
+	  { return __urng(); }
+
+	static void
+	_S_convert(double* __f, const uint64_t* __u, size_t __n,
+		   double __mul, double __add)
+	{
+	  const double __one = 1.0 - numeric_limits<double>::epsilon() / 2;
+	  for (size_t __vl; __n > 0; __n -= __vl, __u += __vl, __f += __vl)
+	    {
+	      __vl = vsetvl_e64m4(__n);
+	      vfloat64m4_t __d
+		= vfcvt_f_xu_v_f64m4(vle64_v_u64m4(__u, __vl), __vl);
+	      __d = vfmin_vf_f64m4(vfmul_vf_f64m4(__d,
+						  1.0 / 18446744073709551616.0,
+						  __vl), __one, __vl);
+	      __d = vfadd_vf_f64m4(vfmul_vf_f64m4(__d, __mul, __vl),
+				   __add, __vl);
+	      vse64_v_f64m4(__f, __d, __vl);
+	    }
+	}
+      };
+
+    template<>
+      struct _Rvv_canonical<float, 32>
+      : _Rvv_canonical_base<float, uint32_t, _Rvv_canonical<float, 32> >
+      {
+	template<typename _UniformRandomNumberGenerator>
+	  static uint32_t
+	  _S_draw(_UniformRandomNumberGenerator& __urng)
+	  { return __urng(); }
+
+	static void
+	_S_convert(float* __f, const uint32_t* __u, size_t __n,
+		   float __mul, float __add)
+	{
+	  const float __one = 1.0f - numeric_limits<float>::epsilon() / 2;
+	  for (size_t __vl; __n > 0; __n -= __vl, __u += __vl, __f += __vl)
+	    {
+	      __vl = vsetvl_e32m4(__n);
+	      vfloat32m4_t __d
+		= vfcvt_f_xu_v_f32m4(vle32_v_u32m4(__u, __vl), __vl);
+	      __d = vfmin_vf_f32m4(vfmul_vf_f32m4(__d, 1.0f / 4294967296.0f,
+						  __vl), __one, __vl);
+	      __d = vfadd_vf_f32m4(vfmul_vf_f32m4(__d, __mul, __vl),
+				   __add, __vl);
+	      vse32_v_f32m4(__f, __d, __vl);
+	    }
+	}
+      };
+
+    template<>
+      struct _Rvv_canonical<float, 64>
+      : _Rvv_canonical_base<float, uint64_t, _Rvv_canonical<float, 64> >
+      {
+	template<typename _UniformRandomNumberGenerator>
+	  static uint64_t
+	  _S_draw(_UniformRandomNumberGenerator& __urng)
+	  { return __urng(); }
+
+	static void
+	_S_convert(float* __f, const uint64_t* __u, size_t __n,
+		   float __mul, float __add)
+	{
+	  const float __one = 1.0f - numeric_limits<float>::epsilon() / 2;
+	  for (size_t __vl; __n > 0; __n -= __vl, __u += __vl, __f += __vl)
+	    {
+	      __vl = vsetvl_e64m4(__n);
+	      vfloat32m2_t __d
+		= vfncvt_f_xu_w_f32m2(vle64_v_u64m4(__u, __vl), __vl);
+	      __d = vfmin_vf_f32m2(vfmul_vf_f32m2(__d,
+						  1.0f / 18446744073709551616.0f,
+						  __vl), __one, __vl);
+	      __d = vfadd_vf_f32m2(vfmul_vf_f32m2(__d, __mul, __vl),
+				   __add, __vl);
+	      vse32_v_f32m2(__f, __d, __vl);
+	    }
+	}
+      };
+  } // namespace __detail
+
+#define _GLIBCXX_RVV_RANDOM_GENERATE(_RealType)				\
+  template<>								\
+    template<typename _UniformRandomNumberGenerator>			\
+      void								\
+      uniform_real_distribution<_RealType>::				\
+      __generate(result_type* __f, result_type* __t,			\
+		 _UniformRandomNumberGenerator& __urng,			\
+		 const param_type& __p)					\
+      {									\
+	typedef __detail::_Rvv_canonical<result_type,			\
+	  __detail::_Rvv_urng_bits<_UniformRandomNumberGenerator>::__value> \
+	  _Canon;							\
+									\
+	if (!_Canon::__value)						\
+	  {								\
+	    this->__generate_impl(__f, __t, __urng, __p);		\
+	    return;							\
+	  }								\
+	_Canon::_S_fill(__f, __t - __f, __urng, __p.b() - __p.a(),	\
+			__p.a());					\
+      }									\
+									\
+  template<>								\
+    template<typename _UniformRandomNumberGenerator>			\
+      void								\
+      normal_distribution<_RealType>::					\
+      __generate(result_type* __f, result_type* __t,			\
+		 _UniformRandomNumberGenerator& __urng,			\
+		 const param_type& __param)				\
+      {									\
+	typedef __detail::_Rvv_canonical<result_type,			\
+	  __detail::_Rvv_urng_bits<_UniformRandomNumberGenerator>::__value> \
+	  _Canon;							\
+									\
+	if (!_Canon::__value || __f == __t)				\
+	  {								\
+	    this->__generate_impl(__f, __t, __urng, __param);		\
+	    return;							\
+	  }								\
+									\
+	if (_M_saved_available)						\
+	  {								\
+	    _M_saved_available = false;					\
+	    *__f++ = _M_saved * __param.stddev() + __param.mean();	\
+	  }								\
+									\
+	/* Draw no more pairs than there are outputs left, so that the  \
+	   engine is left where the scalar loop would leave it.  */	\
+	result_type __xy[128];						\
+	while (__t - __f >= 2)						\
+	  {								\
+	    const size_t __np = (__t - __f) / 2 < 64 ? (__t - __f) / 2 : 64; \
+	    _Canon::_S_fill(__xy, 2 * __np, __urng, result_type(2.0),	\
+			    result_type(-1.0));				\
+	    for (size_t __i = 0; __i < 2 * __np; __i += 2)		\
+	      {								\
+		const result_type __x = __xy[__i], __y = __xy[__i + 1];	\
+		const result_type __r2 = __x * __x + __y * __y;		\
+		if (__r2 > 1.0 || __r2 == 0.0)				\
+		  continue;						\
+		const result_type __mult				\
+		  = std::sqrt(-2 * std::log(__r2) / __r2);		\
+		*__f++ = __y * __mult * __param.stddev() + __param.mean(); \
+		*__f++ = __x * __mult * __param.stddev() + __param.mean(); \
+	      }								\
+	  }								\
+									\
+	if (__f != __t)							\
+	  this->__generate_impl(__f, __t, __urng, __param);		\
+      }
+
+  _GLIBCXX_RVV_RANDOM_GENERATE(float)
+  _GLIBCXX_RVV_RANDOM_GENERATE(double)
+
+#undef _GLIBCXX_RVV_RANDOM_GENERATE
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // __riscv_vector
 
 #endif // _BITS_OPT_RANDOM_H
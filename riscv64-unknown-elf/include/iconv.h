@@ -60,4 +60,6 @@ _iconv_close_r (struct _reent *, iconv_t);
 
 _END_STD_C
 
+#include <machine/iconv.h>
+
 #endif /* #ifndef _ICONV_H_ */
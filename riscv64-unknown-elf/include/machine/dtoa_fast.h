@@ -0,0 +1,303 @@
+/* machine/dtoa_fast.h -- Grisu fast path for _dtoa_r and _ldtoa_r.  */
+
+#ifndef	_MACHDTOA_FAST_H_
+#define	_MACHDTOA_FAST_H_
+
+/* Including this file in exactly one source file of a program, and
+   linking with -Wl,--wrap=_ldtoa_r (for printf in libc.a) or
+   -Wl,--wrap=_dtoa_r (for printf in libc_nano.a, and ecvt and friends),
+   puts a fast path in front of the multiple-precision conversions that
+   printf uses for %e, %f and %g.
+
+   Modes 2 and 3, which ask for a number of significant digits or of
+   digits after the point, are served by Grisu with 64-bit arithmetic
+   (Loitsch, "Printing floating-point numbers quickly and accurately
+   with integers", 2010) when the value is a finite double and at most
+   17 digits are wanted.  Grisu either produces the correctly rounded
+   digits or reports that it cannot tell, as for an exact tie; that,
+   and every other case, goes to the original routine, so the output is
+   unchanged.  The result is kept where the original keeps it, so the
+   two may be mixed freely.  */
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/reent.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern struct _Bigint *_Balloc (struct _reent *, int);
+extern void _Bfree (struct _reent *, struct _Bigint *);
+
+/* Weak, so that a program wrapping only one of the two still links.  */
+extern char *__real__dtoa_r (struct _reent *, double, int, int, int *,
+			     int *, char **) __attribute__ ((__weak__));
+extern char *__real__ldtoa_r (struct _reent *, long double, int, int,
+			      int *, int *, char **) __attribute__ ((__weak__));
+
+/* Normalized 64-bit significands and binary exponents of 10^-348,
+   10^-340, ... 10^340, rounded to nearest.  */
+static const uint64_t __dtoa_pow10_f[] =
+{
+  0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+  0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+  0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+  0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+  0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+  0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+  0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+  0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+  0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+  0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+  0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+  0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+  0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+  0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+  0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+  0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+  0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+  0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+  0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+  0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+  0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+  0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+  0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+  0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+  0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+  0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+  0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+  0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+  0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+
+static const short __dtoa_pow10_e[] =
+{
+  -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+  -954, -927, -901, -874, -847, -821, -794, -768, -741, -715, -688, -661,
+  -635, -608, -582, -555, -529, -502, -475, -449, -422, -396, -369, -343,
+  -316, -289, -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3,
+  30, 56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348, 375, 402,
+  428, 455, 481, 508, 534, 561, 588, 614, 641, 667, 694, 720, 747, 774,
+  800, 827, 853, 880, 907, 933, 960, 986, 1013, 1039, 1066
+};
+
+#define __DTOA_POW10_MIN	(-348)
+#define __DTOA_POW10_STEP	8
+
+static const uint32_t __dtoa_small_pow10[] =
+{
+  0, 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+  1000000000
+};
+
+/* High 64 bits of the 128-bit product of A and B, rounded.  */
+static inline uint64_t
+__dtoa_mul (uint64_t __a, uint64_t __b)
+{
+  uint64_t __ah = __a >> 32, __al = __a & 0xffffffff;
+  uint64_t __bh = __b >> 32, __bl = __b & 0xffffffff;
+  uint64_t __hl = __ah * __bl, __lh = __al * __bh;
+  uint64_t __mid = ((__al * __bl) >> 32) + (__hl & 0xffffffff)
+		   + (__lh & 0xffffffff) + (1u << 31);
+
+  return __ah * __bh + (__hl >> 32) + (__lh >> 32) + (__mid >> 32);
+}
+
+/* Round the LENGTH digits in BUF, followed by REST out of TEN_KAPPA with
+   an error of UNIT either way, or return 0 if the error leaves the
+   rounding direction open.  */
+static int
+__dtoa_round_weed (char *__buf, int __length, uint64_t __rest,
+		   uint64_t __ten_kappa, uint64_t __unit, int *__kappa)
+{
+  int __i;
+
+  if (__unit >= __ten_kappa || __ten_kappa - __unit <= __unit)
+    return 0;
+  if (__ten_kappa - __rest > __rest
+      && __ten_kappa - 2 * __rest >= 2 * __unit)
+    return 1;
+  if (__rest > __unit && __ten_kappa - (__rest - __unit) <= __rest - __unit)
+    {
+      __buf[__length - 1]++;
+      for (__i = __length - 1; __i > 0 && __buf[__i] == '0' + 10; __i--)
+	{
+	  __buf[__i] = '0';
+	  __buf[__i - 1]++;
+	}
+      if (__buf[0] == '0' + 10)
+	{
+	  __buf[0] = '1';
+	  ++*__kappa;
+	}
+      return 1;
+    }
+  return 0;
+}
+
+/* Put the digits of positive finite V for MODE 2 or 3 and NDIGITS in
+   BUF, without trailing zeros, and return their number with the
+   position of the decimal point in *DECPT, or return 0.  */
+static int
+__dtoa_grisu (double __v, int __mode, int __ndigits, char *__buf,
+	      int *__decpt)
+{
+  union { double __d; uint64_t __u; } __x;
+  uint64_t __f, __one, __frac, __err = 1;
+  uint32_t __int, __div;
+  int __e, __k, __i, __mk, __kappa, __want, __len = 0, __sh;
+
+  __x.__d = __v;
+  __f = __x.__u & (((uint64_t) 1 << 52) - 1);
+  __e = (int) (__x.__u >> 52) & 0x7ff;
+  if (__e)
+    __f |= (uint64_t) 1 << 52;
+  else
+    __e = 1;
+  __e -= 1075;
+  __sh = __builtin_clzll (__f);
+  __f <<= __sh;
+  __e -= __sh;
+
+  /* Pick the cached power 10^-MK that brings the exponent of the
+     product into [-60, -32]: K = ceil ((-60 - (E + 64) + 63) * log10 2),
+     with floor (N * log10 2) computed as (N * 78913) >> 18.  */
+  __k = -61 - __e;
+  __k = __k > 0 ? ((__k * 78913) >> 18) + 1 : -((-__k * 78913) >> 18);
+  __i = (-__DTOA_POW10_MIN + __k - 1) / __DTOA_POW10_STEP + 1;
+  __mk = __DTOA_POW10_MIN + __i * __DTOA_POW10_STEP;
+  __f = __dtoa_mul (__f, __dtoa_pow10_f[__i]);
+  __e += __dtoa_pow10_e[__i] + 64;
+
+  __one = (uint64_t) 1 << -__e;
+  __int = (uint32_t) (__f >> -__e);
+  __frac = __f & (__one - 1);
+  __kappa = (((64 + __e + 1) * 1233) >> 12) + 1;
+  if (__int < __dtoa_small_pow10[__kappa])
+    __kappa--;
+  __div = __dtoa_small_pow10[__kappa];
+
+  __want = __mode == 3 ? __ndigits + __kappa - __mk : __ndigits;
+  if (__want < 1 || __want > 17)
+    return 0;
+
+  while (__kappa > 0)
+    {
+      __buf[__len++] = '0' + __int / __div;
+      __int %= __div;
+      __kappa--;
+      if (--__want == 0)
+	break;
+      __div /= 10;
+    }
+  if (__want == 0)
+    {
+      if (!__dtoa_round_weed (__buf, __len,
+			      ((uint64_t) __int << -__e) + __frac,
+			      (uint64_t) __div << -__e, __err, &__kappa))
+	return 0;
+    }
+  else
+    {
+      while (__want > 0 && __frac > __err)
+	{
+	  __frac *= 10;
+	  __err *= 10;
+	  __buf[__len++] = '0' + (int) (__frac >> -__e);
+	  __frac &= __one - 1;
+	  __want--;
+	  __kappa--;
+	}
+      if (__want || !__dtoa_round_weed (__buf, __len, __frac, __one, __err,
+					&__kappa))
+	return 0;
+    }
+
+  *__decpt = __len + __kappa - __mk;
+  while (__len > 1 && __buf[__len - 1] == '0')
+    __len--;
+  return __len;
+}
+
+/* Convert |V| as _dtoa_r would, into the result buffer of R, or return
+   NULL to leave it to the original.  */
+static char *
+__dtoa_fast (struct _reent *__r, double __v, int __mode, int __ndigits,
+	     int *__decpt, int *__sign, char **__rve)
+{
+  char __digits[20], *__s;
+  int __len, __point, __k;
+  size_t __size, __j;
+
+  if ((__mode != 2 && __mode != 3) || __builtin_isinf (__v)
+      || __builtin_isnan (__v))
+    return NULL;
+  *__sign = __builtin_signbit (__v) != 0;
+  if (__v == 0)
+    {
+      __digits[0] = '0';
+      __len = __point = 1;
+    }
+  else if (!(__len = __dtoa_grisu (__builtin_fabs (__v), __mode,
+				   __mode == 2 && __ndigits < 1 ? 1 : __ndigits,
+				   __digits, &__point)))
+    return NULL;
+
+  /* Leave room for printf to append zeros up to the precision.  */
+  __size = __len + (__ndigits > 0 ? __ndigits : 0)
+	   + (__point > 0 ? __point : 0) + 1;
+  _REENT_CHECK_MP (__r);
+  if (_REENT_MP_RESULT (__r))
+    {
+      _REENT_MP_RESULT (__r)->_k = _REENT_MP_RESULT_K (__r);
+      _REENT_MP_RESULT (__r)->_maxwds = 1 << _REENT_MP_RESULT_K (__r);
+      _Bfree (__r, _REENT_MP_RESULT (__r));
+      _REENT_MP_RESULT (__r) = NULL;
+    }
+  for (__k = 0, __j = sizeof (__ULong);
+       sizeof (struct _Bigint) - sizeof (__ULong) + __j <= __size;
+       __j <<= 1)
+    __k++;
+  if (!(_REENT_MP_RESULT (__r) = _Balloc (__r, __k)))
+    return NULL;
+  _REENT_MP_RESULT_K (__r) = __k;
+  __s = (char *) _REENT_MP_RESULT (__r);
+
+  memcpy (__s, __digits, __len);
+  __s[__len] = '\0';
+  *__decpt = __point;
+  if (__rve)
+    *__rve = __s + __len;
+  return __s;
+}
+
+char *
+__wrap__dtoa_r (struct _reent *__r, double __v, int __mode, int __ndigits,
+		int *__decpt, int *__sign, char **__rve)
+{
+  char *__s = __dtoa_fast (__r, __v, __mode, __ndigits, __decpt, __sign,
+			   __rve);
+
+  return __s ? __s : __real__dtoa_r (__r, __v, __mode, __ndigits, __decpt,
+				     __sign, __rve);
+}
+
+char *
+__wrap__ldtoa_r (struct _reent *__r, long double __v, int __mode,
+		 int __ndigits, int *__decpt, int *__sign, char **__rve)
+{
+  char *__s = NULL;
+
+  if ((long double) (double) __v == __v)
+    __s = __dtoa_fast (__r, (double) __v, __mode, __ndigits, __decpt,
+		       __sign, __rve);
+  return __s ? __s : __real__ldtoa_r (__r, __v, __mode, __ndigits, __decpt,
+				      __sign, __rve);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _MACHDTOA_FAST_H_ */
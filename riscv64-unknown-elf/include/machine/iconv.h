@@ -0,0 +1,496 @@
+#ifndef	_MACHICONV_H_
+#define	_MACHICONV_H_
+
+/* Fast paths for the common Unicode conversions.
+
+   Each converter has the calling convention of iconv (3): it advances
+   *INBUF and *OUTBUF, decrements *INLEFT and *OUTLEFT, and returns the
+   number of characters converted.  It stops early, without touching
+   errno, at the first invalid or incomplete sequence or when the output
+   is full; whatever remains is then handed to iconv () on a descriptor
+   for the same pair of encodings, which either carries on or reports
+   the error.
+
+   UCS-4 and UTF-16 are in host byte order (i.e. UCS-4LE and UTF-16LE).
+   Runs of ASCII are the common case and are converted a vector register
+   group at a time when the V extension is available; the scalar code
+   handles everything else.  */
+
+#include <sys/features.h>
+#include <sys/_stdint.h>
+#include <sys/types.h>
+#ifdef __riscv_vector
+#include <riscv_vector.h>
+#endif
+
+#if __MISC_VISIBLE
+
+_BEGIN_STD_C
+
+/* Decode one UTF-8 sequence of S[0..N).  Returns its length, or 0 if it
+   is invalid or incomplete.  */
+static __inline int
+__iconv_utf8_decode (const unsigned char *__s, size_t __n, uint32_t *__cp)
+{
+  uint32_t __c = __s[0], __min;
+  int __len, __i;
+
+  if (__c < 0x80)
+    {
+      *__cp = __c;
+      return 1;
+    }
+  if (__c < 0xc2)
+    return 0;
+  if (__c < 0xe0)
+    __len = 2, __c &= 0x1f, __min = 0x80;
+  else if (__c < 0xf0)
+    __len = 3, __c &= 0x0f, __min = 0x800;
+  else if (__c < 0xf5)
+    __len = 4, __c &= 0x07, __min = 0x10000;
+  else
+    return 0;
+  if (__n < (size_t) __len)
+    return 0;
+  for (__i = 1; __i < __len; __i++)
+    {
+      if ((__s[__i] & 0xc0) != 0x80)
+	return 0;
+      __c = (__c << 6) | (__s[__i] & 0x3f);
+    }
+  if (__c < __min || __c > 0x10ffff || (__c >= 0xd800 && __c <= 0xdfff))
+    return 0;
+  *__cp = __c;
+  return __len;
+}
+
+/* Encode the scalar value CP as UTF-8 into D.  Returns the length.  */
+static __inline int
+__iconv_utf8_encode (uint32_t __cp, unsigned char *__d)
+{
+  if (__cp < 0x80)
+    {
+      __d[0] = __cp;
+      return 1;
+    }
+  if (__cp < 0x800)
+    {
+      __d[0] = 0xc0 | (__cp >> 6);
+      __d[1] = 0x80 | (__cp & 0x3f);
+      return 2;
+    }
+  if (__cp < 0x10000)
+    {
+      __d[0] = 0xe0 | (__cp >> 12);
+      __d[1] = 0x80 | ((__cp >> 6) & 0x3f);
+      __d[2] = 0x80 | (__cp & 0x3f);
+      return 3;
+    }
+  __d[0] = 0xf0 | (__cp >> 18);
+  __d[1] = 0x80 | ((__cp >> 12) & 0x3f);
+  __d[2] = 0x80 | ((__cp >> 6) & 0x3f);
+  __d[3] = 0x80 | (__cp & 0x3f);
+  return 4;
+}
+
+/* The ASCII-run kernels below process at most N units and return how
+   many of them were ASCII (and, except for the span, were copied).  The
+   16- and 32-bit sides must be naturally aligned for the vector loads
+   and stores; otherwise the scalar loop does the work.  */
+
+static __inline size_t
+__iconv_ascii_span (const unsigned char *__s, size_t __n)
+{
+  size_t __i = 0;
+#ifdef __riscv_vector
+  size_t __vl;
+  long __k;
+
+  for (; __i < __n; __i += __vl)
+    {
+      __vl = vsetvl_e8m8 (__n - __i);
+      __k = vfirst_m_b1 (vmsgtu_vx_u8m8_b1 (vle8_v_u8m8 (__s + __i, __vl),
+					  0x7f, __vl), __vl);
+      if (__k >= 0)
+	return __i + __k;
+    }
+#endif
+  while (__i < __n && __s[__i] < 0x80)
+    __i++;
+  return __i;
+}
+
+static __inline size_t
+__iconv_ascii_copy (const unsigned char *__s, unsigned char *__d, size_t __n)
+{
+  size_t __i = 0;
+#ifdef __riscv_vector
+  size_t __vl;
+  long __k;
+  vuint8m8_t __v;
+
+  for (; __i < __n; __i += __vl)
+    {
+      __vl = vsetvl_e8m8 (__n - __i);
+      __v = vle8_v_u8m8 (__s + __i, __vl);
+      __k = vfirst_m_b1 (vmsgtu_vx_u8m8_b1 (__v, 0x7f, __vl), __vl);
+      vse8_v_u8m8 (__d + __i, __v, __k < 0 ? __vl : (size_t) __k);
+      if (__k >= 0)
+	return __i + __k;
+    }
+#endif
+  for (; __i < __n && __s[__i] < 0x80; __i++)
+    __d[__i] = __s[__i];
+  return __i;
+}
+
+static __inline size_t
+__iconv_ascii_to_u16 (const unsigned char *__s, uint16_t *__d, size_t __n)
+{
+  size_t __i = 0;
+#ifdef __riscv_vector
+  size_t __vl;
+  long __k;
+  vuint8m4_t __v;
+
+  if (((uintptr_t) __d & 1) == 0)
+    for (; __i < __n; __i += __vl)
+      {
+	__vl = vsetvl_e8m4 (__n - __i);
+	__v = vle8_v_u8m4 (__s + __i, __vl);
+	__k = vfirst_m_b2 (vmsgtu_vx_u8m4_b2 (__v, 0x7f, __vl), __vl);
+	vse16_v_u16m8 (__d + __i, vwaddu_vx_u16m8 (__v, 0, __vl),
+		       __k < 0 ? __vl : (size_t) __k);
+	if (__k >= 0)
+	  return __i + __k;
+      }
+#endif
+  for (; __i < __n && __s[__i] < 0x80; __i++)
+    {
+      uint16_t __c = __s[__i];
+      __builtin_memcpy (__d + __i, &__c, sizeof __c);
+    }
+  return __i;
+}
+
+static __inline size_t
+__iconv_ascii_to_u32 (const unsigned char *__s, uint32_t *__d, size_t __n)
+{
+  size_t __i = 0;
+#ifdef __riscv_vector
+  size_t __vl;
+  long __k;
+  vuint8m2_t __v;
+
+  if (((uintptr_t) __d & 3) == 0)
+    for (; __i < __n; __i += __vl)
+      {
+	__vl = vsetvl_e8m2 (__n - __i);
+	__v = vle8_v_u8m2 (__s + __i, __vl);
+	__k = vfirst_m_b4 (vmsgtu_vx_u8m2_b4 (__v, 0x7f, __vl), __vl);
+	vse32_v_u32m8 (__d + __i, vwaddu_vx_u32m8 (vwaddu_vx_u16m4 (__v, 0, __vl),
+					       0, __vl),
+		       __k < 0 ? __vl : (size_t) __k);
+	if (__k >= 0)
+	  return __i + __k;
+      }
+#endif
+  for (; __i < __n && __s[__i] < 0x80; __i++)
+    {
+      uint32_t __c = __s[__i];
+      __builtin_memcpy (__d + __i, &__c, sizeof __c);
+    }
+  return __i;
+}
+
+static __inline size_t
+__iconv_u16_to_ascii (const uint16_t *__s, unsigned char *__d, size_t __n)
+{
+  size_t __i = 0;
+  uint16_t __c;
+#ifdef __riscv_vector
+  size_t __vl;
+  long __k;
+  vuint16m8_t __v;
+
+  if (((uintptr_t) __s & 1) == 0)
+    for (; __i < __n; __i += __vl)
+      {
+	__vl = vsetvl_e16m8 (__n - __i);
+	__v = vle16_v_u16m8 (__s + __i, __vl);
+	__k = vfirst_m_b2 (vmsgtu_vx_u16m8_b2 (__v, 0x7f, __vl), __vl);
+	vse8_v_u8m4 (__d + __i, vnsrl_wx_u8m4 (__v, 0, __vl),
+		     __k < 0 ? __vl : (size_t) __k);
+	if (__k >= 0)
+	  return __i + __k;
+      }
+#endif
+  for (; __i < __n; __i++)
+    {
+      __builtin_memcpy (&__c, __s + __i, sizeof __c);
+      if (__c >= 0x80)
+	break;
+      __d[__i] = __c;
+    }
+  return __i;
+}
+
+static __inline size_t
+__iconv_u32_to_ascii (const uint32_t *__s, unsigned char *__d, size_t __n)
+{
+  size_t __i = 0;
+  uint32_t __c;
+#ifdef __riscv_vector
+  size_t __vl;
+  long __k;
+  vuint32m8_t __v;
+
+  if (((uintptr_t) __s & 3) == 0)
+    for (; __i < __n; __i += __vl)
+      {
+	__vl = vsetvl_e32m8 (__n - __i);
+	__v = vle32_v_u32m8 (__s + __i, __vl);
+	__k = vfirst_m_b4 (vmsgtu_vx_u32m8_b4 (__v, 0x7f, __vl), __vl);
+	vse8_v_u8m2 (__d + __i,
+		     vnsrl_wx_u8m2 (vnsrl_wx_u16m4 (__v, 0, __vl), 0, __vl),
+		     __k < 0 ? __vl : (size_t) __k);
+	if (__k >= 0)
+	  return __i + __k;
+      }
+#endif
+  for (; __i < __n; __i++)
+    {
+      __builtin_memcpy (&__c, __s + __i, sizeof __c);
+      if (__c >= 0x80)
+	break;
+      __d[__i] = __c;
+    }
+  return __i;
+}
+
+/* Length of the longest prefix of S[0..N) that is complete, valid UTF-8.
+   Equal to N when the whole buffer is valid.  */
+static __inline size_t
+iconv_utf8_validate (const char *__s, size_t __n)
+{
+  const unsigned char *__p = (const unsigned char *) __s;
+  size_t __i = 0;
+  uint32_t __cp;
+  int __len;
+
+  for (;;)
+    {
+      __i += __iconv_ascii_span (__p + __i, __n - __i);
+      if (__i == __n
+	  || (__len = __iconv_utf8_decode (__p + __i, __n - __i, &__cp)) == 0)
+	return __i;
+      __i += __len;
+    }
+}
+
+/* Length of the leading ASCII run of S[0..N).  ASCII passes through any
+   conversion between ASCII-compatible encodings unchanged, so such a
+   prefix can simply be copied.  */
+static __inline size_t
+iconv_ascii_span (const char *__s, size_t __n)
+{
+  return __iconv_ascii_span ((const unsigned char *) __s, __n);
+}
+
+static __inline size_t
+iconv_utf8_to_ucs4 (const char **__inbuf, size_t *__inleft,
+		    char **__outbuf, size_t *__outleft)
+{
+  const unsigned char *__s = (const unsigned char *) *__inbuf;
+  unsigned char *__d = (unsigned char *) *__outbuf;
+  size_t __n = *__inleft, __room = *__outleft / 4, __count = 0, __run;
+  uint32_t __cp;
+  int __len;
+
+  while (__n > 0 && __room > 0)
+    {
+      __run = __iconv_ascii_to_u32 (__s, (uint32_t *) __d,
+				    __n < __room ? __n : __room);
+      __s += __run, __n -= __run, __d += 4 * __run;
+      __room -= __run, __count += __run;
+      if (__n == 0 || __room == 0
+	  || (__len = __iconv_utf8_decode (__s, __n, &__cp)) == 0)
+	break;
+      __builtin_memcpy (__d, &__cp, 4);
+      __s += __len, __n -= __len, __d += 4, __room--, __count++;
+    }
+  *__outleft -= __d - (unsigned char *) *__outbuf;
+  *__inbuf = (const char *) __s, *__inleft = __n, *__outbuf = (char *) __d;
+  return __count;
+}
+
+static __inline size_t
+iconv_ucs4_to_utf8 (const char **__inbuf, size_t *__inleft,
+		    char **__outbuf, size_t *__outleft)
+{
+  const unsigned char *__s = (const unsigned char *) *__inbuf;
+  unsigned char *__d = (unsigned char *) *__outbuf;
+  size_t __n = *__inleft / 4, __room = *__outleft, __count = 0, __run;
+  uint32_t __cp;
+
+  while (__n > 0 && __room > 0)
+    {
+      __run = __iconv_u32_to_ascii ((const uint32_t *) __s, __d,
+				    __n < __room ? __n : __room);
+      __s += 4 * __run, __n -= __run, __d += __run;
+      __room -= __run, __count += __run;
+      if (__n == 0 || __room == 0)
+	break;
+      __builtin_memcpy (&__cp, __s, 4);
+      if (__cp > 0x10ffff || (__cp >= 0xd800 && __cp <= 0xdfff)
+	  || __room < (__cp < 0x800 ? 2u : __cp < 0x10000 ? 3u : 4u))
+	break;
+      __run = __iconv_utf8_encode (__cp, __d);
+      __s += 4, __n--, __d += __run, __room -= __run, __count++;
+    }
+  *__inleft -= __s - (const unsigned char *) *__inbuf;
+  *__outleft = __room;
+  *__inbuf = (const char *) __s, *__outbuf = (char *) __d;
+  return __count;
+}
+
+static __inline size_t
+iconv_utf8_to_utf16 (const char **__inbuf, size_t *__inleft,
+		     char **__outbuf, size_t *__outleft)
+{
+  const unsigned char *__s = (const unsigned char *) *__inbuf;
+  unsigned char *__d = (unsigned char *) *__outbuf;
+  size_t __n = *__inleft, __room = *__outleft / 2, __count = 0, __run;
+  uint16_t __u[2];
+  uint32_t __cp;
+  int __len;
+
+  while (__n > 0 && __room > 0)
+    {
+      __run = __iconv_ascii_to_u16 (__s, (uint16_t *) __d,
+				    __n < __room ? __n : __room);
+      __s += __run, __n -= __run, __d += 2 * __run;
+      __room -= __run, __count += __run;
+      if (__n == 0 || __room == 0
+	  || (__len = __iconv_utf8_decode (__s, __n, &__cp)) == 0)
+	break;
+      if (__cp < 0x10000)
+	{
+	  __u[0] = __cp;
+	  __builtin_memcpy (__d, __u, 2);
+	  __d += 2, __room--;
+	}
+      else
+	{
+	  if (__room < 2)
+	    break;
+	  __cp -= 0x10000;
+	  __u[0] = 0xd800 | (__cp >> 10);
+	  __u[1] = 0xdc00 | (__cp & 0x3ff);
+	  __builtin_memcpy (__d, __u, 4);
+	  __d += 4, __room -= 2;
+	}
+      __s += __len, __n -= __len, __count++;
+    }
+  *__outleft -= __d - (unsigned char *) *__outbuf;
+  *__inbuf = (const char *) __s, *__inleft = __n, *__outbuf = (char *) __d;
+  return __count;
+}
+
+static __inline size_t
+iconv_utf16_to_utf8 (const char **__inbuf, size_t *__inleft,
+		     char **__outbuf, size_t *__outleft)
+{
+  const unsigned char *__s = (const unsigned char *) *__inbuf;
+  unsigned char *__d = (unsigned char *) *__outbuf;
+  size_t __n = *__inleft / 2, __room = *__outleft, __count = 0, __run;
+  uint16_t __u[2];
+  uint32_t __cp;
+  int __len;
+
+  while (__n > 0 && __room > 0)
+    {
+      __run = __iconv_u16_to_ascii ((const uint16_t *) __s, __d,
+				    __n < __room ? __n : __room);
+      __s += 2 * __run, __n -= __run, __d += __run;
+      __room -= __run, __count += __run;
+      if (__n == 0 || __room == 0)
+	break;
+      __builtin_memcpy (__u, __s, 2);
+      __cp = __u[0];
+      __run = 1;
+      if (__cp >= 0xd800 && __cp <= 0xdfff)
+	{
+	  if (__cp >= 0xdc00 || __n < 2)
+	    break;
+	  __builtin_memcpy (__u + 1, __s + 2, 2);
+	  if (__u[1] < 0xdc00 || __u[1] > 0xdfff)
+	    break;
+	  __cp = 0x10000 + ((__cp & 0x3ff) << 10) + (__u[1] & 0x3ff);
+	  __run = 2;
+	}
+      if (__room < (__cp < 0x800 ? 2u : __cp < 0x10000 ? 3u : 4u))
+	break;
+      __len = __iconv_utf8_encode (__cp, __d);
+      __s += 2 * __run, __n -= __run, __d += __len, __room -= __len, __count++;
+    }
+  *__inleft -= __s - (const unsigned char *) *__inbuf;
+  *__outleft = __room;
+  *__inbuf = (const char *) __s, *__outbuf = (char *) __d;
+  return __count;
+}
+
+static __inline size_t
+iconv_latin1_to_utf8 (const char **__inbuf, size_t *__inleft,
+		      char **__outbuf, size_t *__outleft)
+{
+  const unsigned char *__s = (const unsigned char *) *__inbuf;
+  unsigned char *__d = (unsigned char *) *__outbuf;
+  size_t __n = *__inleft, __room = *__outleft, __count = 0, __run;
+
+  while (__n > 0 && __room > 0)
+    {
+      __run = __iconv_ascii_copy (__s, __d, __n < __room ? __n : __room);
+      __s += __run, __n -= __run, __d += __run;
+      __room -= __run, __count += __run;
+      if (__n == 0 || __room < 2)
+	break;
+      __d[0] = 0xc0 | (__s[0] >> 6);
+      __d[1] = 0x80 | (__s[0] & 0x3f);
+      __s++, __n--, __d += 2, __room -= 2, __count++;
+    }
+  *__inbuf = (const char *) __s, *__inleft = __n;
+  *__outbuf = (char *) __d, *__outleft = __room;
+  return __count;
+}
+
+static __inline size_t
+iconv_utf8_to_latin1 (const char **__inbuf, size_t *__inleft,
+		      char **__outbuf, size_t *__outleft)
+{
+  const unsigned char *__s = (const unsigned char *) *__inbuf;
+  unsigned char *__d = (unsigned char *) *__outbuf;
+  size_t __n = *__inleft, __room = *__outleft, __count = 0, __run;
+
+  while (__n > 0 && __room > 0)
+    {
+      __run = __iconv_ascii_copy (__s, __d, __n < __room ? __n : __room);
+      __s += __run, __n -= __run, __d += __run;
+      __room -= __run, __count += __run;
+      /* Only C2 and C3 lead bytes decode to U+0080..U+00FF.  */
+      if (__n < 2 || __room == 0 || (__s[0] & 0xfe) != 0xc2
+	  || (__s[1] & 0xc0) != 0x80)
+	break;
+      *__d++ = (__s[0] << 6) | (__s[1] & 0x3f);
+      __s += 2, __n -= 2, __room--, __count++;
+    }
+  *__inbuf = (const char *) __s, *__inleft = __n;
+  *__outbuf = (char *) __d, *__outleft = __room;
+  return __count;
+}
+
+_END_STD_C
+
+#endif /* __MISC_VISIBLE */
+
+#endif	/* _MACHICONV_H_ */
@@ -1,8 +1,104 @@
 #ifndef	_MACHMALLOC_H_
 #define	_MACHMALLOC_H_
 
-/* place holder so platforms may add malloc.h extensions */
+/* RISC-V extensions to malloc.h.  */
 
-#endif	/* _MACHMALLOC_H_ */
+#include <sys/reent.h>
+
+#define __need_size_t
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Hooks of the multi-arena allocator in <machine/mallocr.h>.  They are
+   only defined in programs that include that file.
+
+   __malloc_arena_hook, if set, returns the arena of the calling thread
+   (taken modulo the number of arenas); by default the hart's mhartid
+   selects it.  __malloc_tcache_hook, if set, returns the address of a
+   per-thread pointer (for instance a field of the RTOS task control
+   block) in which the allocator keeps the thread's free-list cache; the
+   pointer must start out NULL.  A thread that exits passes the same
+   address to malloc_tcache_flush to return its cached chunks.  */
+
+extern unsigned (*__malloc_arena_hook) (void);
+extern void **(*__malloc_tcache_hook) (void);
+
+extern void malloc_tcache_flush (void **);
+extern void _malloc_tcache_flush_r (struct _reent *, void **);
+
+/* Heap profile kept by <machine/mallocr.h> when _MALLOC_PROFILE is
+   defined.  Roughly every RATE bytes of allocation, the block that
+   crosses the mark is recorded with the return addresses of its caller
+   into a ring of SLOTS samples.  Each sample is 3 + DEPTH words: the
+   block (cleared when it is freed), the size requested, the bytes of
+   allocation the sample stands for, then DEPTH return addresses, the
+   innermost first and zero past the end of the trace.  TAKEN counts
+   every sample taken, so the oldest ones have been overwritten once it
+   exceeds SLOTS.  The live samples, scaled by their weight, estimate
+   what is still allocated and where from; all of them estimate where
+   the allocation happens.
+
+   A debugger or host tool can read __malloc_profile and the ring it
+   points to straight from target memory, or malloc_profile_dump can
+   write both to a file, through semihosting when the program is linked
+   with librdimon.  Setting RATE to 0 pauses sampling; a new non-zero
+   RATE is picked up within about _MALLOC_PROFILE_RATE bytes (the
+   compile-time rate) of allocation.  */
+
+#define MALLOC_PROFILE_MAGIC	0x666f7270	/* "prof" */
 
+struct malloc_profile
+{
+  unsigned long magic;
+  unsigned long rate;
+  unsigned long depth;
+  unsigned long slots;
+  unsigned long taken;
+  unsigned long *samples;
+};
 
+extern struct malloc_profile __malloc_profile;
+
+extern int malloc_profile_dump (const char *);
+extern int _malloc_profile_dump_r (struct _reent *, const char *);
+
+/* Pools of fixed-size objects, also defined by <machine/mallocr.h>.
+   malloc_pool_create makes a pool of objects of SIZE bytes, aligned as
+   malloc aligns, which it carves from slabs taken from malloc.
+   malloc_pool_alloc and malloc_pool_free then take and return an object
+   of the pool in constant time, with no per-object header.
+   malloc_pool_destroy gives all the slabs back to malloc, along with
+   any objects still allocated from them.
+
+   With MALLOC_POOL_MAGAZINES, each arena index keeps a magazine of free
+   objects that it uses without locking, exchanging full magazines with
+   the pool.  This is only safe where one thread at a time runs with a
+   given index, as with one thread per hart.
+
+   mallinfo counts the free objects of all pools, and the space not yet
+   carved from their slabs, in fsmblks rather than uordblks, and the
+   number of free objects in smblks.  */
+
+#define MALLOC_POOL_MAGAZINES	1
+
+struct malloc_pool;
+
+extern struct malloc_pool *malloc_pool_create (size_t, int);
+extern struct malloc_pool *_malloc_pool_create_r (struct _reent *, size_t,
+						  int);
+extern void malloc_pool_destroy (struct malloc_pool *);
+extern void _malloc_pool_destroy_r (struct _reent *, struct malloc_pool *);
+extern void *malloc_pool_alloc (struct malloc_pool *);
+extern void *_malloc_pool_alloc_r (struct _reent *, struct malloc_pool *);
+extern void malloc_pool_free (struct malloc_pool *, void *);
+extern void _malloc_pool_free_r (struct _reent *, struct malloc_pool *,
+				 void *);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _MACHMALLOC_H_ */
@@ -0,0 +1,1360 @@
+/* machine/mallocr.h -- multi-arena replacement for the newlib allocator.  */
+
+#ifndef	_MACHMALLOCR_H_
+#define	_MACHMALLOCR_H_
+
+/* Including this file in exactly one source file of a program defines
+   _malloc_r, _free_r, _realloc_r, _calloc_r, _memalign_r and the rest
+   of the reentrant allocator entry points, along with posix_memalign
+   and aligned_alloc, so the linker takes them from the program instead
+   of mallocr.o (or nano-mallocr.o) in libc.a.  malloc, free and
+   friends in libc.a call through to these.
+
+   Memory is divided among _MALLOC_ARENAS arenas, each with its own lock
+   and its own bins, so harts allocating in parallel do not meet on a
+   single lock.  An arena grows by at least _MALLOC_ARENA_SEGMENT bytes
+   at a time from sbrk, which is the only step taking __malloc_lock.
+   Chunks remember their arena, so they may be freed from any hart.
+
+   Threads may also keep a small cache of free chunks of each size up to
+   _MALLOC_TCACHE_MAX bytes, _MALLOC_TCACHE_COUNT deep, which serves
+   malloc and free without any lock.  The cache is found through
+   __malloc_tcache_hook, or thread-local storage when
+   _MALLOC_TCACHE_TLS is defined; see <machine/malloc.h>.  Cached chunks
+   count as in use in mallinfo until they are reused or flushed.
+
+   Arena locks are spin locks by default, which suits one thread per
+   hart.  Systems that preempt threads on a hart should define
+   _MALLOC_ARENA_LOCK and _MALLOC_ARENA_UNLOCK to a sleeping lock, or to
+   a section with preemption disabled; they take a pointer to the
+   arena's int lock word.
+
+   Free chunks sit in segregated bins: _MALLOC_NSMALL bins of exact
+   sizes, then two bins per power of two up to _MALLOC_NBINS in all.  A
+   bitmap of non-empty bins finds the next larger class in constant
+   time, and malloc looks at no more than _MALLOC_BIN_SEARCH chunks of
+   the request's own class before moving on to it, so both malloc and
+   free take bounded time whatever the fragmentation.  Only when no
+   larger class has a chunk does malloc search the whole of its own
+   class before growing the heap.  Within the window it takes the first
+   chunk that fits, or with _MALLOC_BEST_FIT the smallest.  Defining
+   _MALLOC_NO_COALESCE leaves freed chunks unmerged, for the smallest
+   code; malloc_trim and the keepcost of mallinfo then only see the one
+   free chunk next to the end of the heap, not the free space below it.
+
+   Defining _MALLOC_PROFILE keeps the sampling heap profile described
+   in <machine/malloc.h>: about every _MALLOC_PROFILE_RATE bytes, an
+   allocation is recorded with up to _MALLOC_PROFILE_DEPTH return
+   addresses in a ring of _MALLOC_PROFILE_SLOTS samples.  Between samples
+   malloc only subtracts the request from a counter and free tests one
+   word of the chunk.  The addresses come from _Unwind_Backtrace, so the
+   program needs -fasynchronous-unwind-tables for the trace to reach
+   past the allocator.
+
+   The object pools of <machine/malloc.h> take slabs of
+   _MALLOC_POOL_SLAB bytes from malloc, or one object if that is larger,
+   and exchange magazines of _MALLOC_POOL_MAGAZINE objects.
+
+   Defining _MALLOC_NANO selects a configuration for programs linked
+   with libc_nano.a: one arena under __malloc_lock, no thread caches,
+   growth by the request size only, and fewer bins.  Any of the
+   parameters above can still be set explicitly.  */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdio.h>
+#include <malloc.h>
+#include <reent.h>
+#ifdef _MALLOC_PROFILE
+#include <fcntl.h>
+#include <unwind.h>
+#endif
+
+#ifdef _MALLOC_NANO
+#ifndef _MALLOC_ARENAS
+#define _MALLOC_ARENAS 1
+#endif
+#ifndef _MALLOC_ARENA_SEGMENT
+#define _MALLOC_ARENA_SEGMENT 0
+#endif
+#ifndef _MALLOC_TCACHE_COUNT
+#define _MALLOC_TCACHE_COUNT 0
+#endif
+#ifndef _MALLOC_NSMALL
+#define _MALLOC_NSMALL 8
+#endif
+#ifndef _MALLOC_NBINS
+#define _MALLOC_NBINS 24
+#endif
+#ifndef _MALLOC_BIN_SEARCH
+#define _MALLOC_BIN_SEARCH 4
+#endif
+#ifndef _MALLOC_ARENA_LOCK
+#define _MALLOC_ARENA_LOCK(l) __malloc_lock (_REENT)
+#define _MALLOC_ARENA_UNLOCK(l) __malloc_unlock (_REENT)
+#endif
+#endif
+
+#ifndef _MALLOC_ARENAS
+#define _MALLOC_ARENAS 4
+#endif
+
+#ifndef _MALLOC_ARENA_SEGMENT
+#define _MALLOC_ARENA_SEGMENT (64 * 1024)
+#endif
+
+#ifndef _MALLOC_TCACHE_COUNT
+#define _MALLOC_TCACHE_COUNT 8
+#endif
+
+/* _MALLOC_NSMALL must be a power of two and _MALLOC_NBINS no more
+   than 64.  */
+#ifndef _MALLOC_NSMALL
+#define _MALLOC_NSMALL 32
+#endif
+
+#ifndef _MALLOC_NBINS
+#define _MALLOC_NBINS 64
+#endif
+
+#ifndef _MALLOC_BIN_SEARCH
+#define _MALLOC_BIN_SEARCH 16
+#endif
+
+#ifndef _MALLOC_TCACHE_MAX
+#define _MALLOC_TCACHE_MAX 256
+#endif
+
+#ifndef _MALLOC_ARENA_INDEX
+#if _MALLOC_ARENAS == 1
+#define _MALLOC_ARENA_INDEX() 0u
+#else
+#define _MALLOC_ARENA_INDEX() \
+  (__malloc_arena_hook ? __malloc_arena_hook () : __malloc_hartid ())
+#endif
+#endif
+
+#ifndef _MALLOC_ARENA_LOCK
+#ifdef __riscv_atomic
+#define _MALLOC_ARENA_LOCK(l) __malloc_spin_lock (l)
+#define _MALLOC_ARENA_UNLOCK(l) __atomic_store_n (l, 0, __ATOMIC_RELEASE)
+#else
+#define _MALLOC_ARENA_LOCK(l) __malloc_lock (_REENT)
+#define _MALLOC_ARENA_UNLOCK(l) __malloc_unlock (_REENT)
+#endif
+#endif
+
+#ifndef _MALLOC_PAGESIZE
+#define _MALLOC_PAGESIZE 4096
+#endif
+
+#ifndef _MALLOC_POOL_SLAB
+#define _MALLOC_POOL_SLAB 4096
+#endif
+
+#ifndef _MALLOC_POOL_MAGAZINE
+#define _MALLOC_POOL_MAGAZINE 16
+#endif
+
+#ifndef _MALLOC_PROFILE_RATE
+#define _MALLOC_PROFILE_RATE (512 * 1024)
+#endif
+
+/* _MALLOC_PROFILE_SLOTS must be below 65535.  */
+#ifndef _MALLOC_PROFILE_SLOTS
+#define _MALLOC_PROFILE_SLOTS 128
+#endif
+
+#ifndef _MALLOC_PROFILE_DEPTH
+#define _MALLOC_PROFILE_DEPTH 8
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A chunk starts with its size and two flag bits, followed by the index
+   of its arena while in use, or the bin links and, in its last word, a
+   copy of its size while free.  The payload follows the first two
+   words, so every chunk is a multiple of and aligned to two words.  */
+
+struct __malloc_chunk
+{
+  size_t __head;
+  struct __malloc_chunk *__fd;
+  struct __malloc_chunk *__bk;
+};
+
+#define __MALLOC_SZ		sizeof (size_t)
+#define __MALLOC_ALIGN		(2 * __MALLOC_SZ)
+#define __MALLOC_HDR		(2 * __MALLOC_SZ)
+#define __MALLOC_MINCHUNK	(4 * __MALLOC_SZ)
+#define __MALLOC_INUSE		1
+#define __MALLOC_PINUSE		2
+#define __MALLOC_FLAGS		3
+
+/* While a chunk is in use, the low half of __fd holds its arena and the
+   high half one more than its profile slot, if it was sampled.  */
+#define __MALLOC_SAMPLE_SHIFT	(sizeof (size_t) * 4)
+#define __MALLOC_ARENA_MASK	(((size_t) 1 << __MALLOC_SAMPLE_SHIFT) - 1)
+
+/* Bin N < _MALLOC_NSMALL holds chunks of exactly N * __MALLOC_ALIGN
+   bytes; above that, each power of two is split between two bins and
+   the last bin takes everything larger.  */
+#define __MALLOC_NBINS		_MALLOC_NBINS
+#define __MALLOC_NSMALL		_MALLOC_NSMALL
+#define __MALLOC_SMALL_MAX	(__MALLOC_NSMALL * __MALLOC_ALIGN)
+
+#if __MALLOC_NBINS > 32
+typedef uint64_t __malloc_binmap_t;
+#define __malloc_first_bin(m)	__builtin_ctzll (m)
+#else
+typedef uint32_t __malloc_binmap_t;
+#define __malloc_first_bin(m)	__builtin_ctzl (m)
+#endif
+
+#define __MALLOC_TCACHE_BINS	(_MALLOC_TCACHE_MAX / __MALLOC_ALIGN + 1)
+
+#define __malloc_size(c)	((c)->__head & ~(size_t) __MALLOC_FLAGS)
+#define __malloc_at(c, n)	((struct __malloc_chunk *) ((char *) (c) + (n)))
+#define __malloc_before(c, n)	((struct __malloc_chunk *) ((char *) (c) - (n)))
+#define __malloc_mem(c)		((void *) ((char *) (c) + __MALLOC_HDR))
+#define __malloc_chunk_of(p) \
+  ((struct __malloc_chunk *) ((char *) (p) - __MALLOC_HDR))
+#define __malloc_footer(c) \
+  (*(size_t *) ((char *) (c) + __malloc_size (c) - __MALLOC_SZ))
+
+struct __malloc_arena
+{
+  int __lock;
+  __malloc_binmap_t __binmap;
+  struct __malloc_chunk *__bins[__MALLOC_NBINS];
+  /* Fencepost closing the most recent segment.  */
+  struct __malloc_chunk *__end;
+  size_t __system;
+  size_t __inuse;
+  size_t __free;
+  size_t __nfree;
+};
+
+struct __malloc_tcache
+{
+  struct __malloc_chunk *__bins[__MALLOC_TCACHE_BINS];
+  unsigned short __count[__MALLOC_TCACHE_BINS];
+};
+
+static struct __malloc_arena __malloc_arenas[_MALLOC_ARENAS];
+static size_t __malloc_max_system;
+static size_t __malloc_top_pad;
+
+unsigned (*__malloc_arena_hook) (void);
+void **(*__malloc_tcache_hook) (void);
+
+#ifdef _MALLOC_TCACHE_TLS
+static __thread void *__malloc_tcache_tls;
+#endif
+
+#ifdef _MALLOC_PROFILE
+#define __MALLOC_SAMPLE_WORDS	(3 + _MALLOC_PROFILE_DEPTH)
+
+static unsigned long __malloc_samples[_MALLOC_PROFILE_SLOTS
+				      * __MALLOC_SAMPLE_WORDS];
+
+struct malloc_profile __malloc_profile =
+{
+  MALLOC_PROFILE_MAGIC, _MALLOC_PROFILE_RATE, _MALLOC_PROFILE_DEPTH,
+  _MALLOC_PROFILE_SLOTS, 0, __malloc_samples
+};
+
+/* Bytes left before the next sample, out of the __malloc_profile_interval
+   drawn at the last one.  */
+static ptrdiff_t __malloc_profile_left = _MALLOC_PROFILE_RATE;
+static ptrdiff_t __malloc_profile_interval = _MALLOC_PROFILE_RATE;
+/* Set while the rate is 0, when the countdown only looks at the rate
+   again every _MALLOC_PROFILE_RATE bytes.  */
+static int __malloc_profile_paused;
+static uint64_t __malloc_profile_seed = 1;
+static int __malloc_profile_busy;
+
+#ifdef __riscv_atomic
+#define __MALLOC_PROFILE_SUB(n) \
+  __atomic_sub_fetch (&__malloc_profile_left, (n), __ATOMIC_RELAXED)
+#define __MALLOC_PROFILE_SET(n) \
+  __atomic_store_n (&__malloc_profile_left, (n), __ATOMIC_RELAXED)
+#define __MALLOC_PROFILE_TRYLOCK() \
+  (!__atomic_exchange_n (&__malloc_profile_busy, 1, __ATOMIC_ACQUIRE))
+#define __MALLOC_PROFILE_UNLOCK() \
+  __atomic_store_n (&__malloc_profile_busy, 0, __ATOMIC_RELEASE)
+#else
+#define __MALLOC_PROFILE_SUB(n)		(__malloc_profile_left -= (n))
+#define __MALLOC_PROFILE_SET(n)		(__malloc_profile_left = (n))
+#define __MALLOC_PROFILE_TRYLOCK() \
+  (!__malloc_profile_busy && (__malloc_profile_busy = 1))
+#define __MALLOC_PROFILE_UNLOCK()	(__malloc_profile_busy = 0)
+#endif
+#endif
+
+static inline unsigned
+__malloc_hartid (void)
+{
+  unsigned long __id;
+
+  __asm__ __volatile__ ("csrr\t%0, mhartid" : "=r" (__id));
+  return __id;
+}
+
+static inline void
+__malloc_spin_lock (int *__l)
+{
+  while (__atomic_exchange_n (__l, 1, __ATOMIC_ACQUIRE))
+    while (__atomic_load_n (__l, __ATOMIC_RELAXED))
+      ;
+}
+
+static inline unsigned
+__malloc_bin (size_t __s)
+{
+  unsigned __lg, __i;
+
+  if (__s < __MALLOC_SMALL_MAX)
+    return __s / __MALLOC_ALIGN;
+  __lg = sizeof (unsigned long) * 8 - 1 - __builtin_clzl (__s);
+  __i = __MALLOC_NSMALL
+	+ 2 * (__lg - __builtin_ctzl (__MALLOC_SMALL_MAX))
+	+ ((__s >> (__lg - 1)) & 1);
+  return __i < __MALLOC_NBINS ? __i : __MALLOC_NBINS - 1;
+}
+
+/* Chunk size for a request of N bytes, or 0 if it cannot be met.  */
+static inline size_t
+__malloc_request (size_t __n)
+{
+  size_t __s;
+
+  if (__n > (size_t) PTRDIFF_MAX - __MALLOC_HDR - __MALLOC_ALIGN)
+    return 0;
+  __s = (__n + __MALLOC_HDR + __MALLOC_ALIGN - 1) & -__MALLOC_ALIGN;
+  return __s < __MALLOC_MINCHUNK ? __MALLOC_MINCHUNK : __s;
+}
+
+static inline struct __malloc_arena *
+__malloc_arena_of (struct __malloc_chunk *__c)
+{
+  return &__malloc_arenas[(size_t) __c->__fd & __MALLOC_ARENA_MASK];
+}
+
+static inline void
+__malloc_link (struct __malloc_arena *__a, struct __malloc_chunk *__c)
+{
+  unsigned __i = __malloc_bin (__malloc_size (__c));
+
+  __c->__fd = __a->__bins[__i];
+  __c->__bk = NULL;
+  if (__c->__fd)
+    __c->__fd->__bk = __c;
+  __a->__bins[__i] = __c;
+  __a->__binmap |= (__malloc_binmap_t) 1 << __i;
+}
+
+static inline void
+__malloc_unlink (struct __malloc_arena *__a, struct __malloc_chunk *__c)
+{
+  unsigned __i = __malloc_bin (__malloc_size (__c));
+
+  if (__c->__bk)
+    __c->__bk->__fd = __c->__fd;
+  else if (!(__a->__bins[__i] = __c->__fd))
+    __a->__binmap &= ~((__malloc_binmap_t) 1 << __i);
+  if (__c->__fd)
+    __c->__fd->__bk = __c->__bk;
+}
+
+/* Return the in-use chunk C to its arena, merging it with free
+   neighbours.  */
+static void
+__malloc_release (struct __malloc_arena *__a, struct __malloc_chunk *__c)
+{
+  size_t __s = __malloc_size (__c);
+  struct __malloc_chunk *__n = __malloc_at (__c, __s);
+
+  __a->__inuse -= __s;
+  __a->__free += __s;
+  __a->__nfree++;
+#ifndef _MALLOC_NO_COALESCE
+  if (!(__n->__head & __MALLOC_INUSE))
+    {
+      __malloc_unlink (__a, __n);
+      __s += __malloc_size (__n);
+      __a->__nfree--;
+    }
+  if (!(__c->__head & __MALLOC_PINUSE))
+    {
+      size_t __ps = *((size_t *) __c - 1);
+
+      __c = __malloc_before (__c, __ps);
+      __malloc_unlink (__a, __c);
+      __s += __ps;
+      __a->__nfree--;
+    }
+  __c->__head = __s | __MALLOC_PINUSE;
+#else
+  /* Unmerged, but still with the footer and the cleared PINUSE that
+     trim and keepcost look for below the fencepost.  */
+  (void) __n;
+  __c->__head &= ~(size_t) __MALLOC_INUSE;
+#endif
+  __malloc_footer (__c) = __s;
+  __malloc_at (__c, __s)->__head &= ~(size_t) __MALLOC_PINUSE;
+  __malloc_link (__a, __c);
+}
+
+/* Cut in-use chunk C down to S bytes, freeing the rest.  */
+static inline void
+__malloc_split (struct __malloc_arena *__a, struct __malloc_chunk *__c,
+		size_t __s)
+{
+  size_t __cs = __malloc_size (__c);
+  struct __malloc_chunk *__t;
+
+  if (__cs - __s < __MALLOC_MINCHUNK)
+    return;
+  __t = __malloc_at (__c, __s);
+  __c->__head = __s | (__c->__head & __MALLOC_FLAGS);
+  __t->__head = (__cs - __s) | __MALLOC_INUSE | __MALLOC_PINUSE;
+  __malloc_release (__a, __t);
+}
+
+/* The first chunk of at least S bytes among the first K of list P, or
+   with _MALLOC_BEST_FIT the smallest.  */
+static inline struct __malloc_chunk *
+__malloc_fit (struct __malloc_chunk *__p, size_t __s, size_t __k)
+{
+  struct __malloc_chunk *__c = NULL;
+
+  for (; __p && __k--; __p = __p->__fd)
+    if (__malloc_size (__p) >= __s
+	&& (!__c || __malloc_size (__p) < __malloc_size (__c)))
+      {
+	__c = __p;
+#ifndef _MALLOC_BEST_FIT
+	break;
+#else
+	if (__malloc_size (__p) == __s)
+	  break;
+#endif
+      }
+  return __c;
+}
+
+/* Take a chunk of at least S bytes from the bins of A, or NULL.  Every
+   chunk of a higher class than S is large enough, so only the class of
+   S itself is searched, and that only _MALLOC_BIN_SEARCH deep unless
+   the alternative is to grow the arena.  */
+static struct __malloc_chunk *
+__malloc_take (struct __malloc_arena *__a, size_t __s)
+{
+  unsigned __i = __malloc_bin (__s);
+  struct __malloc_chunk *__c = __a->__bins[__i];
+  __malloc_binmap_t __m;
+
+  if (__c && __malloc_size (__c) != __s)
+    __c = __malloc_fit (__c, __s, _MALLOC_BIN_SEARCH);
+  if (!__c)
+    {
+      __m = __i + 1 < __MALLOC_NBINS
+	    ? __a->__binmap & ((__malloc_binmap_t) -1 << (__i + 1)) : 0;
+      if (__m)
+	__c = __a->__bins[__malloc_first_bin (__m)];
+      else if (!(__c = __malloc_fit (__a->__bins[__i], __s, (size_t) -1)))
+	return NULL;
+    }
+  __malloc_unlink (__a, __c);
+  __a->__free -= __malloc_size (__c);
+  __a->__inuse += __malloc_size (__c);
+  __a->__nfree--;
+  __c->__head |= __MALLOC_INUSE;
+  __malloc_at (__c, __malloc_size (__c))->__head |= __MALLOC_PINUSE;
+  __malloc_split (__a, __c, __s);
+  return __c;
+}
+
+/* Add at least S bytes of free memory to A from sbrk.  */
+static int
+__malloc_grow (struct _reent *__r, struct __malloc_arena *__a, size_t __s)
+{
+  size_t __n = __s + 2 * __MALLOC_HDR + __malloc_top_pad;
+  size_t __total = 0, __i;
+  struct __malloc_chunk *__c;
+  char *__p;
+
+  if (__n < _MALLOC_ARENA_SEGMENT)
+    __n = _MALLOC_ARENA_SEGMENT;
+  __n = (__n + __MALLOC_ALIGN - 1) & -__MALLOC_ALIGN;
+  __malloc_lock (__r);
+  __p = (char *) _sbrk_r (__r, __n);
+  if (__p != (char *) -1)
+    {
+      __a->__system += __n;
+      for (__i = 0; __i < _MALLOC_ARENAS; __i++)
+	__total += __malloc_arenas[__i].__system;
+      if (__total > __malloc_max_system)
+	__malloc_max_system = __total;
+    }
+  __malloc_unlock (__r);
+  if (__p == (char *) -1)
+    return 0;
+
+  if (__a->__end && __p == (char *) __a->__end + __MALLOC_HDR)
+    {
+      /* Contiguous with the last segment: reuse its fencepost.  */
+      __c = __a->__end;
+      __c->__head = __n | __MALLOC_INUSE | (__c->__head & __MALLOC_PINUSE);
+    }
+  else
+    {
+      __c = (struct __malloc_chunk *)
+	    (((uintptr_t) __p + __MALLOC_ALIGN - 1) & -__MALLOC_ALIGN);
+      __c->__head = (((__p + __n - (char *) __c) & -__MALLOC_ALIGN)
+		     - __MALLOC_HDR)
+		    | __MALLOC_INUSE | __MALLOC_PINUSE;
+    }
+  __a->__end = __malloc_at (__c, __malloc_size (__c));
+  __a->__end->__head = __MALLOC_INUSE;
+  __a->__inuse += __malloc_size (__c);
+  __malloc_release (__a, __c);
+  return 1;
+}
+
+static struct __malloc_chunk *
+__malloc_alloc (struct _reent *__r, struct __malloc_arena *__a, size_t __s)
+{
+  struct __malloc_chunk *__c;
+
+  _MALLOC_ARENA_LOCK (&__a->__lock);
+  __c = __malloc_take (__a, __s);
+  if (!__c && __malloc_grow (__r, __a, __s))
+    __c = __malloc_take (__a, __s);
+  _MALLOC_ARENA_UNLOCK (&__a->__lock);
+  if (__c)
+    __c->__fd = (struct __malloc_chunk *) (size_t) (__a - __malloc_arenas);
+  else
+    __r->_errno = ENOMEM;
+  return __c;
+}
+
+static inline struct __malloc_tcache *
+__malloc_tcache (struct _reent *__r)
+{
+  void **__slot = NULL;
+
+  if (_MALLOC_TCACHE_COUNT == 0)
+    return NULL;
+  if (__malloc_tcache_hook)
+    __slot = __malloc_tcache_hook ();
+#ifdef _MALLOC_TCACHE_TLS
+  else
+    __slot = &__malloc_tcache_tls;
+#endif
+  if (!__slot)
+    return NULL;
+  if (!*__slot)
+    {
+      struct __malloc_arena *__a
+	= &__malloc_arenas[_MALLOC_ARENA_INDEX () % _MALLOC_ARENAS];
+      struct __malloc_chunk *__c
+	= __malloc_alloc (__r, __a,
+			  __malloc_request (sizeof (struct __malloc_tcache)));
+
+      if (!__c)
+	return NULL;
+      memset (__malloc_mem (__c), 0, sizeof (struct __malloc_tcache));
+      *__slot = __malloc_mem (__c);
+    }
+  return (struct __malloc_tcache *) *__slot;
+}
+
+static void
+__malloc_free_chunk (struct __malloc_chunk *__c)
+{
+  struct __malloc_arena *__a = __malloc_arena_of (__c);
+
+  _MALLOC_ARENA_LOCK (&__a->__lock);
+  __malloc_release (__a, __c);
+  _MALLOC_ARENA_UNLOCK (&__a->__lock);
+}
+
+#ifdef _MALLOC_PROFILE
+struct __malloc_trace
+{
+  unsigned long *__pc;
+  int __skip;
+  int __n;
+};
+
+static _Unwind_Reason_Code
+__malloc_trace_frame (struct _Unwind_Context *__ctx, void *__arg)
+{
+  struct __malloc_trace *__t = (struct __malloc_trace *) __arg;
+
+  if (__t->__skip > 0)
+    {
+      __t->__skip--;
+      return _URC_NO_REASON;
+    }
+  __t->__pc[__t->__n++] = _Unwind_GetIP (__ctx);
+  return __t->__n < _MALLOC_PROFILE_DEPTH ? _URC_NO_REASON
+					   : _URC_END_OF_STACK;
+}
+
+/* Record chunk C, of N bytes requested, and draw the distance to the
+   next sample uniformly from [RATE / 2, 3 * RATE / 2).  A sample that
+   comes while another is being taken, by another hart or by the
+   unwinder's own allocations, is dropped.  While RATE is 0, nothing is
+   recorded and the rate is checked again after _MALLOC_PROFILE_RATE
+   bytes; the first countdown after it is set again only re-arms.  */
+static void __attribute__ ((__noinline__, __cold__))
+__malloc_profile_take (struct __malloc_chunk *__c, size_t __n)
+{
+  struct __malloc_trace __t;
+  unsigned long *__s;
+  size_t __slot, __rate;
+  ptrdiff_t __weight;
+  int __paused;
+
+  if (!__MALLOC_PROFILE_TRYLOCK ())
+    return;
+  __weight = __malloc_profile_interval - __malloc_profile_left;
+  __rate = __malloc_profile.rate;
+  __paused = __malloc_profile_paused;
+  __malloc_profile_paused = !__rate;
+  if (__rate)
+    {
+      __malloc_profile_seed = __malloc_profile_seed * 6364136223846793005ULL
+			      + 1442695040888963407ULL;
+      __malloc_profile_interval = __rate / 2
+				  + (__malloc_profile_seed >> 33) % __rate;
+    }
+  else
+    __malloc_profile_interval = _MALLOC_PROFILE_RATE;
+  __MALLOC_PROFILE_SET (__malloc_profile_interval);
+  if (!__rate || __paused)
+    goto out;
+
+  __slot = __malloc_profile.taken++ % _MALLOC_PROFILE_SLOTS;
+  __s = &__malloc_samples[__slot * __MALLOC_SAMPLE_WORDS];
+  __s[0] = 0;
+  __s[1] = __n;
+  __s[2] = __weight;
+  memset (&__s[3], 0, _MALLOC_PROFILE_DEPTH * sizeof (unsigned long));
+  /* Leave out this function and the allocator entry point.  */
+  __t.__pc = &__s[3];
+  __t.__skip = 2;
+  __t.__n = 0;
+  _Unwind_Backtrace (__malloc_trace_frame, &__t);
+  __s[0] = (unsigned long) __malloc_mem (__c);
+  __c->__fd = (struct __malloc_chunk *)
+	      (((size_t) __c->__fd & __MALLOC_ARENA_MASK)
+	       | (__slot + 1) << __MALLOC_SAMPLE_SHIFT);
+ out:
+  __MALLOC_PROFILE_UNLOCK ();
+}
+
+static void __attribute__ ((__noinline__, __cold__))
+__malloc_profile_drop (struct __malloc_chunk *__c, size_t __tag)
+{
+  unsigned long *__s = &__malloc_samples[(__tag - 1) * __MALLOC_SAMPLE_WORDS];
+
+  __c->__fd = (struct __malloc_chunk *)
+	      ((size_t) __c->__fd & __MALLOC_ARENA_MASK);
+  /* The slot may since have been reused for another block.  */
+  if (__s[0] == (unsigned long) __malloc_mem (__c))
+    __s[0] = 0;
+}
+#endif
+
+/* Count N bytes allocated in chunk C towards the next profile sample
+   and return its memory.  */
+static inline void *
+__malloc_note (struct __malloc_chunk *__c, size_t __n)
+{
+#ifdef _MALLOC_PROFILE
+  if (__builtin_expect (__MALLOC_PROFILE_SUB ((ptrdiff_t) __n) < 0, 0))
+    __malloc_profile_take (__c, __n);
+#else
+  (void) __n;
+#endif
+  return __malloc_mem (__c);
+}
+
+/* Update the sample of chunk C, if any, for a resize in place to N
+   bytes.  */
+static inline void
+__malloc_renote (struct __malloc_chunk *__c, size_t __n)
+{
+#ifdef _MALLOC_PROFILE
+  size_t __tag = (size_t) __c->__fd >> __MALLOC_SAMPLE_SHIFT;
+
+  unsigned long *__s;
+
+  if (!__tag)
+    return;
+  __s = &__malloc_samples[(__tag - 1) * __MALLOC_SAMPLE_WORDS];
+  /* The slot may since have been reused for another block.  */
+  if (__s[0] == (unsigned long) __malloc_mem (__c))
+    __s[1] = __n;
+#else
+  (void) __c;
+  (void) __n;
+#endif
+}
+
+/* Mark the sample of chunk C, if any, freed.  */
+static inline void
+__malloc_forget (struct __malloc_chunk *__c)
+{
+#ifdef _MALLOC_PROFILE
+  size_t __tag = (size_t) __c->__fd >> __MALLOC_SAMPLE_SHIFT;
+
+  if (__builtin_expect (__tag != 0, 0))
+    __malloc_profile_drop (__c, __tag);
+#else
+  (void) __c;
+#endif
+}
+
+void *
+_malloc_r (struct _reent *__r, size_t __n)
+{
+  size_t __s = __malloc_request (__n);
+  struct __malloc_chunk *__c;
+
+  if (!__s)
+    {
+      __r->_errno = ENOMEM;
+      return NULL;
+    }
+  if (__s <= _MALLOC_TCACHE_MAX)
+    {
+      struct __malloc_tcache *__tc = __malloc_tcache (__r);
+      size_t __i = __s / __MALLOC_ALIGN;
+
+      if (__tc && (__c = __tc->__bins[__i]))
+	{
+	  __tc->__bins[__i] = __c->__bk;
+	  __tc->__count[__i]--;
+	  return __malloc_note (__c, __n);
+	}
+    }
+  __c = __malloc_alloc (__r,
+			&__malloc_arenas[_MALLOC_ARENA_INDEX ()
+					 % _MALLOC_ARENAS], __s);
+  return __c ? __malloc_note (__c, __n) : NULL;
+}
+
+void
+_free_r (struct _reent *__r, void *__p)
+{
+  struct __malloc_chunk *__c;
+  size_t __s;
+
+  if (!__p)
+    return;
+  __c = __malloc_chunk_of (__p);
+  __s = __malloc_size (__c);
+  __malloc_forget (__c);
+  if (__s <= _MALLOC_TCACHE_MAX)
+    {
+      struct __malloc_tcache *__tc = __malloc_tcache (__r);
+      size_t __i = __s / __MALLOC_ALIGN;
+
+      if (__tc && __tc->__count[__i] < _MALLOC_TCACHE_COUNT)
+	{
+	  __c->__bk = __tc->__bins[__i];
+	  __tc->__bins[__i] = __c;
+	  __tc->__count[__i]++;
+	  return;
+	}
+    }
+  __malloc_free_chunk (__c);
+}
+
+void
+_malloc_tcache_flush_r (struct _reent *__r, void **__slot)
+{
+  struct __malloc_tcache *__tc = (struct __malloc_tcache *) *__slot;
+  struct __malloc_chunk *__c;
+  size_t __i;
+
+  (void) __r;
+  if (!__tc)
+    return;
+  *__slot = NULL;
+  for (__i = 0; __i < __MALLOC_TCACHE_BINS; __i++)
+    while ((__c = __tc->__bins[__i]))
+      {
+	__tc->__bins[__i] = __c->__bk;
+	__malloc_free_chunk (__c);
+      }
+  __malloc_free_chunk (__malloc_chunk_of (__tc));
+}
+
+void
+malloc_tcache_flush (void **__slot)
+{
+  _malloc_tcache_flush_r (_REENT, __slot);
+}
+
+void *
+_realloc_r (struct _reent *__r, void *__p, size_t __n)
+{
+  struct __malloc_arena *__a;
+  struct __malloc_chunk *__c, *__nx;
+  size_t __s, __cs;
+  void *__q;
+
+  if (!__p)
+    return _malloc_r (__r, __n);
+  if (__n == 0)
+    {
+      _free_r (__r, __p);
+      return NULL;
+    }
+  if (!(__s = __malloc_request (__n)))
+    {
+      __r->_errno = ENOMEM;
+      return NULL;
+    }
+  __c = __malloc_chunk_of (__p);
+  __a = __malloc_arena_of (__c);
+  __cs = __malloc_size (__c);
+
+  _MALLOC_ARENA_LOCK (&__a->__lock);
+  __nx = __malloc_at (__c, __cs);
+  if (__cs < __s && !(__nx->__head & __MALLOC_INUSE)
+      && __cs + __malloc_size (__nx) >= __s)
+    {
+      /* Grow in place into the free chunk that follows.  */
+      __malloc_unlink (__a, __nx);
+      __a->__free -= __malloc_size (__nx);
+      __a->__inuse += __malloc_size (__nx);
+      __a->__nfree--;
+      __cs += __malloc_size (__nx);
+      __c->__head = __cs | (__c->__head & __MALLOC_FLAGS);
+      __malloc_at (__c, __cs)->__head |= __MALLOC_PINUSE;
+    }
+  if (__cs >= __s)
+    {
+      __malloc_split (__a, __c, __s);
+      _MALLOC_ARENA_UNLOCK (&__a->__lock);
+      __malloc_renote (__c, __n);
+      return __p;
+    }
+  _MALLOC_ARENA_UNLOCK (&__a->__lock);
+
+  if (!(__q = _malloc_r (__r, __n)))
+    return NULL;
+  memcpy (__q, __p, __cs - __MALLOC_HDR);
+  _free_r (__r, __p);
+  return __q;
+}
+
+void *
+_calloc_r (struct _reent *__r, size_t __n, size_t __size)
+{
+  size_t __bytes;
+  void *__p;
+
+  if (__builtin_mul_overflow (__n, __size, &__bytes))
+    {
+      __r->_errno = ENOMEM;
+      return NULL;
+    }
+  if ((__p = _malloc_r (__r, __bytes)))
+    memset (__p, 0, __bytes);
+  return __p;
+}
+
+void *
+_memalign_r (struct _reent *__r, size_t __align, size_t __n)
+{
+  struct __malloc_arena *__a;
+  struct __malloc_chunk *__c, *__ac;
+  size_t __s, __lead;
+
+  if (__align <= __MALLOC_ALIGN)
+    return _malloc_r (__r, __n);
+  if (__align & (__align - 1))
+    __align = (size_t) 1 << (sizeof (unsigned long) * 8
+			     - __builtin_clzl (__align));
+  if (!(__s = __malloc_request (__n))
+      || __s > (size_t) PTRDIFF_MAX - __align - __MALLOC_MINCHUNK)
+    {
+      __r->_errno = ENOMEM;
+      return NULL;
+    }
+
+  /* Chunk memory is already __MALLOC_ALIGN aligned, so this much always
+     leaves room for a leading chunk and an aligned one of __s bytes.  */
+  __a = &__malloc_arenas[_MALLOC_ARENA_INDEX () % _MALLOC_ARENAS];
+  if (!(__c = __malloc_alloc (__r, __a, __s + __align - __MALLOC_ALIGN
+					  + __MALLOC_MINCHUNK)))
+    return NULL;
+
+  _MALLOC_ARENA_LOCK (&__a->__lock);
+  __ac = __c;
+  if ((uintptr_t) __malloc_mem (__c) & (__align - 1))
+    {
+      /* Free a leading chunk of at least __MALLOC_MINCHUNK bytes.  */
+      __ac = (struct __malloc_chunk *)
+	     ((((uintptr_t) __c + __MALLOC_HDR + __MALLOC_MINCHUNK
+		+ __align - 1) & -__align) - __MALLOC_HDR);
+      __lead = (char *) __ac - (char *) __c;
+      __ac->__head = (__malloc_size (__c) - __lead)
+		     | __MALLOC_INUSE | __MALLOC_PINUSE;
+      __c->__head = __lead | (__c->__head & __MALLOC_FLAGS);
+      __malloc_release (__a, __c);
+    }
+  __malloc_split (__a, __ac, __s);
+  _MALLOC_ARENA_UNLOCK (&__a->__lock);
+  __ac->__fd = (struct __malloc_chunk *) (size_t) (__a - __malloc_arenas);
+  return __malloc_note (__ac, __n);
+}
+
+/* Out-of-line versions of the inline definitions in <stdlib.h>, also
+   needed by aligned_alloc.o in libc.a.  */
+
+int
+posix_memalign (void **__memptr, size_t __align, size_t __n)
+{
+  struct _reent *__r = _REENT;
+  int __errno_saved = __r->_errno;
+  void *__p;
+
+  if (__align == 0 || (__align & (__align - 1))
+      || __align % sizeof (void *))
+    return EINVAL;
+  __p = _memalign_r (__r, __align, __n);
+  __r->_errno = __errno_saved;
+  if (!__p)
+    return ENOMEM;
+  *__memptr = __p;
+  return 0;
+}
+
+void *
+aligned_alloc (size_t __align, size_t __n)
+{
+  if (__align == 0 || (__align & (__align - 1)))
+    {
+      _REENT->_errno = EINVAL;
+      return NULL;
+    }
+  return _memalign_r (_REENT, __align, __n);
+}
+
+void *
+_valloc_r (struct _reent *__r, size_t __n)
+{
+  return _memalign_r (__r, _MALLOC_PAGESIZE, __n);
+}
+
+void *
+_pvalloc_r (struct _reent *__r, size_t __n)
+{
+  if (__n > (size_t) PTRDIFF_MAX - _MALLOC_PAGESIZE)
+    {
+      __r->_errno = ENOMEM;
+      return NULL;
+    }
+  return _memalign_r (__r, _MALLOC_PAGESIZE,
+		      (__n + _MALLOC_PAGESIZE - 1) & -_MALLOC_PAGESIZE);
+}
+
+size_t
+_malloc_usable_size_r (struct _reent *__r, void *__p)
+{
+  (void) __r;
+  return __p ? __malloc_size (__malloc_chunk_of (__p)) - __MALLOC_HDR : 0;
+}
+
+/* Give the free tail of each arena above PAD bytes back to sbrk, where
+   it is the last thing sbrk handed out.  */
+int
+_malloc_trim_r (struct _reent *__r, size_t __pad)
+{
+  int __trimmed = 0;
+  size_t __i;
+
+  for (__i = 0; __i < _MALLOC_ARENAS; __i++)
+    {
+      struct __malloc_arena *__a = &__malloc_arenas[__i];
+      struct __malloc_chunk *__c, *__end;
+      size_t __s, __cut;
+
+      _MALLOC_ARENA_LOCK (&__a->__lock);
+      __end = __a->__end;
+      if (!__end || (__end->__head & __MALLOC_PINUSE))
+	goto next;
+      __s = *((size_t *) __end - 1);
+      __c = __malloc_before (__end, __s);
+      if (__s < __MALLOC_MINCHUNK + __pad + _MALLOC_PAGESIZE)
+	goto next;
+      __cut = (__s - __MALLOC_MINCHUNK - __pad) & -_MALLOC_PAGESIZE;
+      __malloc_lock (__r);
+      if (_sbrk_r (__r, 0) == (char *) __end + __MALLOC_HDR
+	  && _sbrk_r (__r, -(ptrdiff_t) __cut) != (void *) -1)
+	{
+	  __malloc_unlink (__a, __c);
+	  __c->__head = (__s - __cut) | (__c->__head & __MALLOC_PINUSE);
+	  __malloc_footer (__c) = __s - __cut;
+	  __malloc_link (__a, __c);
+	  __a->__end = __malloc_at (__c, __s - __cut);
+	  __a->__end->__head = __MALLOC_INUSE;
+	  __a->__system -= __cut;
+	  __a->__free -= __cut;
+	  __trimmed = 1;
+	}
+      __malloc_unlock (__r);
+    next:
+      _MALLOC_ARENA_UNLOCK (&__a->__lock);
+    }
+  return __trimmed;
+}
+
+/* A pool carves its objects from a list of slabs, each starting with a
+   link to the previous one.  A free object holds the next free object in
+   its first word and, at the head of a full magazine, the next full
+   magazine in its second.  Magazines only go back to the pool when full,
+   so every magazine in __full holds _MALLOC_POOL_MAGAZINE objects.  */
+
+struct __malloc_magazine
+{
+  void *__top;
+  size_t __count;
+};
+
+struct malloc_pool
+{
+  int __lock;
+  int __flags;
+  size_t __size;
+  size_t __slab;
+  char *__bump;
+  char *__limit;
+  void *__slabs;
+  /* Free objects, and full magazines, held by the pool itself.  */
+  void *__free;
+  void *__full;
+  size_t __nfree;
+  struct malloc_pool *__next;
+  struct __malloc_magazine __mags[_MALLOC_ARENAS];
+};
+
+static struct malloc_pool *__malloc_pools;
+
+/* Carve up to N objects of pool PL into a list, taking a new slab if the
+   current one is used up, and store their number in *GOT.  */
+static void *
+__malloc_pool_carve (struct _reent *__r, struct malloc_pool *__pl,
+		     size_t __n, size_t *__got)
+{
+  void *__head = NULL;
+  char *__sl;
+
+  *__got = 0;
+  if (__pl->__bump == __pl->__limit)
+    {
+      if (!(__sl = (char *) _malloc_r (__r, __pl->__slab)))
+	return NULL;
+      *(void **) __sl = __pl->__slabs;
+      __pl->__slabs = __sl;
+      __pl->__bump = __sl + __MALLOC_ALIGN;
+      __pl->__limit = __pl->__bump + (__pl->__slab - __MALLOC_ALIGN)
+				     / __pl->__size * __pl->__size;
+    }
+  while (*__got < __n && __pl->__bump < __pl->__limit)
+    {
+      *(void **) __pl->__bump = __head;
+      __head = __pl->__bump;
+      __pl->__bump += __pl->__size;
+      ++*__got;
+    }
+  return __head;
+}
+
+static int __attribute__ ((__noinline__))
+__malloc_pool_refill (struct _reent *__r, struct malloc_pool *__pl,
+		      struct __malloc_magazine *__m)
+{
+  void **__o;
+
+  _MALLOC_ARENA_LOCK (&__pl->__lock);
+  if ((__o = (void **) __pl->__full))
+    {
+      __pl->__full = __o[1];
+      __pl->__nfree -= _MALLOC_POOL_MAGAZINE;
+      __m->__top = __o;
+      __m->__count = _MALLOC_POOL_MAGAZINE;
+    }
+  else
+    __m->__top = __malloc_pool_carve (__r, __pl, _MALLOC_POOL_MAGAZINE,
+				      &__m->__count);
+  _MALLOC_ARENA_UNLOCK (&__pl->__lock);
+  return __m->__count != 0;
+}
+
+static void __attribute__ ((__noinline__))
+__malloc_pool_spill (struct malloc_pool *__pl, struct __malloc_magazine *__m)
+{
+  void **__o = (void **) __m->__top;
+
+  _MALLOC_ARENA_LOCK (&__pl->__lock);
+  __o[1] = __pl->__full;
+  __pl->__full = __o;
+  __pl->__nfree += _MALLOC_POOL_MAGAZINE;
+  _MALLOC_ARENA_UNLOCK (&__pl->__lock);
+  __m->__top = NULL;
+  __m->__count = 0;
+}
+
+struct malloc_pool *
+_malloc_pool_create_r (struct _reent *__r, size_t __size, int __flags)
+{
+  struct malloc_pool *__pl;
+
+  if (__size > (size_t) PTRDIFF_MAX - _MALLOC_POOL_SLAB - 2 * __MALLOC_ALIGN)
+    {
+      __r->_errno = ENOMEM;
+      return NULL;
+    }
+  if (!(__pl = (struct malloc_pool *) _malloc_r (__r, sizeof (*__pl))))
+    return NULL;
+  memset (__pl, 0, sizeof (*__pl));
+  __pl->__flags = __flags;
+  __pl->__size = (__size + __MALLOC_ALIGN - 1) & -__MALLOC_ALIGN;
+  if (!__pl->__size)
+    __pl->__size = __MALLOC_ALIGN;
+  __pl->__slab = __MALLOC_ALIGN + __pl->__size;
+  if (__pl->__slab < _MALLOC_POOL_SLAB)
+    __pl->__slab = _MALLOC_POOL_SLAB;
+
+  __malloc_lock (__r);
+  __pl->__next = __malloc_pools;
+  __malloc_pools = __pl;
+  __malloc_unlock (__r);
+  return __pl;
+}
+
+void
+_malloc_pool_destroy_r (struct _reent *__r, struct malloc_pool *__pl)
+{
+  struct malloc_pool **__pp;
+  void *__sl, *__next;
+
+  if (!__pl)
+    return;
+  __malloc_lock (__r);
+  for (__pp = &__malloc_pools; *__pp != __pl; __pp = &(*__pp)->__next)
+    ;
+  *__pp = __pl->__next;
+  __malloc_unlock (__r);
+  for (__sl = __pl->__slabs; __sl; __sl = __next)
+    {
+      __next = *(void **) __sl;
+      _free_r (__r, __sl);
+    }
+  _free_r (__r, __pl);
+}
+
+void *
+_malloc_pool_alloc_r (struct _reent *__r, struct malloc_pool *__pl)
+{
+  void **__o;
+  size_t __got;
+
+  if (__pl->__flags & MALLOC_POOL_MAGAZINES)
+    {
+      struct __malloc_magazine *__m
+	= &__pl->__mags[_MALLOC_ARENA_INDEX () % _MALLOC_ARENAS];
+
+      if (__builtin_expect (!__m->__count, 0)
+	  && !__malloc_pool_refill (__r, __pl, __m))
+	return NULL;
+      __o = (void **) __m->__top;
+      __m->__top = *__o;
+      __m->__count--;
+      return __o;
+    }
+
+  _MALLOC_ARENA_LOCK (&__pl->__lock);
+  if ((__o = (void **) __pl->__free))
+    {
+      __pl->__free = *__o;
+      __pl->__nfree--;
+    }
+  else
+    __o = (void **) __malloc_pool_carve (__r, __pl, 1, &__got);
+  _MALLOC_ARENA_UNLOCK (&__pl->__lock);
+  return __o;
+}
+
+void
+_malloc_pool_free_r (struct _reent *__r, struct malloc_pool *__pl, void *__p)
+{
+  void **__o = (void **) __p;
+
+  (void) __r;
+  if (!__p)
+    return;
+  if (__pl->__flags & MALLOC_POOL_MAGAZINES)
+    {
+      struct __malloc_magazine *__m
+	= &__pl->__mags[_MALLOC_ARENA_INDEX () % _MALLOC_ARENAS];
+
+      if (__builtin_expect (__m->__count == _MALLOC_POOL_MAGAZINE, 0))
+	__malloc_pool_spill (__pl, __m);
+      *__o = __m->__top;
+      __m->__top = __o;
+      __m->__count++;
+      return;
+    }
+
+  _MALLOC_ARENA_LOCK (&__pl->__lock);
+  *__o = __pl->__free;
+  __pl->__free = __o;
+  __pl->__nfree++;
+  _MALLOC_ARENA_UNLOCK (&__pl->__lock);
+}
+
+struct malloc_pool *
+malloc_pool_create (size_t __size, int __flags)
+{
+  return _malloc_pool_create_r (_REENT, __size, __flags);
+}
+
+void
+malloc_pool_destroy (struct malloc_pool *__pl)
+{
+  _malloc_pool_destroy_r (_REENT, __pl);
+}
+
+void *
+malloc_pool_alloc (struct malloc_pool *__pl)
+{
+  return _malloc_pool_alloc_r (_REENT, __pl);
+}
+
+void
+malloc_pool_free (struct malloc_pool *__pl, void *__p)
+{
+  _malloc_pool_free_r (_REENT, __pl, __p);
+}
+
+struct mallinfo
+_mallinfo_r (struct _reent *__r)
+{
+  struct mallinfo __mi;
+  struct malloc_pool *__pl;
+  size_t __i;
+
+  memset (&__mi, 0, sizeof (__mi));
+  for (__i = 0; __i < _MALLOC_ARENAS; __i++)
+    {
+      struct __malloc_arena *__a = &__malloc_arenas[__i];
+
+      _MALLOC_ARENA_LOCK (&__a->__lock);
+      __mi.arena += __a->__system;
+      __mi.ordblks += __a->__nfree;
+      __mi.uordblks += __a->__inuse;
+      __mi.fordblks += __a->__free;
+      if (__a->__end && !(__a->__end->__head & __MALLOC_PINUSE))
+	__mi.keepcost += *((size_t *) __a->__end - 1);
+      _MALLOC_ARENA_UNLOCK (&__a->__lock);
+    }
+
+  /* A pool may hold its lock while it takes __malloc_lock to grow, so
+     pools are read without locking them, and the figures are only a
+     snapshot.  */
+  __malloc_lock (__r);
+  for (__pl = __malloc_pools; __pl; __pl = __pl->__next)
+    {
+      size_t __n = __pl->__nfree;
+
+      __mi.fsmblks += __pl->__limit - __pl->__bump;
+      for (__i = 0; __i < _MALLOC_ARENAS; __i++)
+	__n += __pl->__mags[__i].__count;
+      __mi.smblks += __n;
+      __mi.fsmblks += __n * __pl->__size;
+    }
+  __malloc_unlock (__r);
+  __mi.uordblks -= __mi.fsmblks;
+  return __mi;
+}
+
+void
+_malloc_stats_r (struct _reent *__r)
+{
+  struct mallinfo __mi = _mallinfo_r (__r);
+  size_t __i;
+
+  _REENT_SMALL_CHECK_INIT (__r);
+  for (__i = 0; __i < _MALLOC_ARENAS; __i++)
+    if (__malloc_arenas[__i].__system)
+      _fiprintf_r (__r, _stderr_r (__r),
+		   "arena %u: system bytes = %10u in use bytes = %10u\n",
+		   (unsigned int) __i,
+		   (unsigned int) __malloc_arenas[__i].__system,
+		   (unsigned int) __malloc_arenas[__i].__inuse);
+  _fiprintf_r (__r, _stderr_r (__r), "max system bytes = %10u\n",
+	       (unsigned int) __malloc_max_system);
+  _fiprintf_r (__r, _stderr_r (__r), "system bytes     = %10u\n",
+	       (unsigned int) __mi.arena);
+  _fiprintf_r (__r, _stderr_r (__r), "in use bytes     = %10u\n",
+	       (unsigned int) __mi.uordblks);
+}
+
+int
+_mallopt_r (struct _reent *__r, int __param, int __value)
+{
+  (void) __r;
+  if (__param == M_TOP_PAD && __value >= 0)
+    {
+      __malloc_top_pad = __value;
+      return 1;
+    }
+  return 0;
+}
+
+#ifdef _MALLOC_PROFILE
+/* Write __malloc_profile, then its ring of samples, to PATH.  */
+int
+_malloc_profile_dump_r (struct _reent *__r, const char *__path)
+{
+  int __fd, __ok;
+
+  if ((__fd = _open_r (__r, __path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0)
+    return -1;
+  __ok = _write_r (__r, __fd, &__malloc_profile, sizeof (__malloc_profile))
+	 == (_ssize_t) sizeof (__malloc_profile)
+	 && _write_r (__r, __fd, __malloc_samples, sizeof (__malloc_samples))
+	    == (_ssize_t) sizeof (__malloc_samples);
+  if (_close_r (__r, __fd) < 0)
+    __ok = 0;
+  return __ok ? 0 : -1;
+}
+
+int
+malloc_profile_dump (const char *__path)
+{
+  return _malloc_profile_dump_r (_REENT, __path);
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _MACHMALLOCR_H_ */
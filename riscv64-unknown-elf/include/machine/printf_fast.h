@@ -0,0 +1,296 @@
+/* machine/printf_fast.h -- fast path for integer formats in printf.  */
+
+#ifndef	_MACHPRINTF_FAST_H_
+#define	_MACHPRINTF_FAST_H_
+
+/* Including this file in exactly one source file of a program, and
+   linking with -Wl,--wrap=_vfprintf_r,--wrap=_svfprintf_r, puts a fast
+   path in front of the printf family of libc.a and libc_nano.a:
+   _vfprintf_r serves printf, fprintf and vprintf, and _svfprintf_r
+   serves sprintf, snprintf and vsprintf.
+
+   A format whose conversions are all %d, %i, %u, %o, %x, %X, %c, %s or
+   %%, with no flags, width or precision, is formatted directly into a
+   buffer of _PRINTF_FAST_BUFSIZ bytes on the stack and handed to the
+   stream in one write.  Decimal numbers are converted two digits at a
+   time from a table.  The length modifiers are those the library
+   accepts (hh, j, z and t only with C99 formats, ll only with long long
+   support).  None of these conversions depends on the locale.
+
+   Any other format, output that does not fit in the buffer, a null %s
+   argument and the asprintf family go to the original routine, which
+   sees the arguments from the start, so the output is unchanged.  */
+
+#include <newlib.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/reent.h>
+
+#ifndef _PRINTF_FAST_BUFSIZ
+#define _PRINTF_FAST_BUFSIZ 256
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Weak, so that a program wrapping only one of the two still links.  */
+extern int __real__vfprintf_r (struct _reent *, FILE *, const char *,
+			       va_list) __attribute__ ((__weak__));
+extern int __real__svfprintf_r (struct _reent *, FILE *, const char *,
+				va_list) __attribute__ ((__weak__));
+
+static const char __printf_fast_digits[201] =
+  "0001020304050607080910111213141516171819"
+  "2021222324252627282930313233343536373839"
+  "4041424344454647484950515253545556575859"
+  "6061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+/* Write V in BASE backwards from END and return where it starts.  */
+static char *
+__printf_fast_ulong (char *__end, unsigned long __v, int __base,
+		     const char *__xdigits)
+{
+  const char *__d;
+
+  if (__base != 10)
+    {
+      const int __sh = __base == 8 ? 3 : 4;
+
+      do
+	{
+	  *--__end = __xdigits[__v & (__base - 1)];
+	  __v >>= __sh;
+	}
+      while (__v);
+      return __end;
+    }
+  while (__v >= 100)
+    {
+      __d = &__printf_fast_digits[(__v % 100) * 2];
+      __v /= 100;
+      *--__end = __d[1];
+      *--__end = __d[0];
+    }
+  if (__v >= 10)
+    {
+      __d = &__printf_fast_digits[__v * 2];
+      *--__end = __d[1];
+      *--__end = __d[0];
+    }
+  else
+    *--__end = '0' + __v;
+  return __end;
+}
+
+/* The same for a long long, which on RV32 is wider than a long.  Eight
+   decimal digits are split off at a time while the rest does not fit in
+   a long, so that most of the work is done by 32-bit divisions.  */
+static char *
+__printf_fast_ullong (char *__end, unsigned long long __v, int __base,
+		      const char *__xdigits)
+{
+  unsigned long __lo;
+  int __i;
+
+  if (__base != 10)
+    {
+      const int __sh = __base == 8 ? 3 : 4;
+
+      while (__v > ULONG_MAX)
+	{
+	  *--__end = __xdigits[__v & (__base - 1)];
+	  __v >>= __sh;
+	}
+    }
+  else
+    while (__v > ULONG_MAX)
+      {
+	__lo = __v % 100000000;
+	__v /= 100000000;
+	for (__i = 0; __i < 4; __i++)
+	  {
+	    *--__end = __printf_fast_digits[(__lo % 100) * 2 + 1];
+	    *--__end = __printf_fast_digits[(__lo % 100) * 2];
+	    __lo /= 100;
+	  }
+      }
+  return __printf_fast_ulong (__end, __v, __base, __xdigits);
+}
+
+/* Format FMT with the arguments AP into BUF, and return the length, or
+   -1 when the format or the output is not for the fast path.  */
+static int
+__printf_fast (char *__buf, const char *__fmt, va_list __ap)
+{
+  char *__p = __buf, *const __end = __buf + _PRINTF_FAST_BUFSIZ;
+  char __tmp[3 * sizeof (long long)], *__s;
+  const char *__pct, *__str;
+  unsigned long long __u;
+  long long __v;
+  size_t __n;
+  int __mod, __base;
+
+  for (;;)
+    {
+      __pct = strchr (__fmt, '%');
+      __n = __pct ? (size_t) (__pct - __fmt) : strlen (__fmt);
+      if (__n > (size_t) (__end - __p))
+	return -1;
+      memcpy (__p, __fmt, __n);
+      __p += __n;
+      if (!__pct)
+	return __p - __buf;
+      __fmt = __pct + 1;
+
+      /* The length modifier, with hh as 'H' and ll as 'L'.  */
+      __mod = 0;
+      switch (*__fmt)
+	{
+	case 'h':
+	  __mod = *++__fmt == 'h' ? 'H' : 'h';
+	  break;
+	case 'l':
+	  __mod = *++__fmt == 'l' ? 'L' : 'l';
+	  break;
+	case 'j':
+	case 'z':
+	case 't':
+	  __mod = *__fmt++;
+	  break;
+	}
+      if (__mod == 'H' || __mod == 'L')
+	__fmt++;
+#ifndef _WANT_IO_C99_FORMATS
+      if (__mod == 'H' || __mod == 'j' || __mod == 'z' || __mod == 't')
+	return -1;
+#endif
+#ifndef _WANT_IO_LONG_LONG
+      if (__mod == 'L' || __mod == 'j')
+	return -1;
+#endif
+
+      __s = __tmp + sizeof __tmp;
+      switch (*__fmt++)
+	{
+	case '%':
+	  if (__mod)
+	    return -1;
+	  *--__s = '%';
+	  break;
+	case 'c':
+	  if (__mod)
+	    return -1;
+	  *--__s = (char) va_arg (__ap, int);
+	  break;
+	case 's':
+	  if (__mod || !(__str = va_arg (__ap, const char *)))
+	    return -1;
+	  __n = strlen (__str);
+	  if (__n > (size_t) (__end - __p))
+	    return -1;
+	  memcpy (__p, __str, __n);
+	  __p += __n;
+	  continue;
+	case 'd':
+	case 'i':
+	  switch (__mod)
+	    {
+	    case 'H': __v = (signed char) va_arg (__ap, int); break;
+	    case 'h': __v = (short) va_arg (__ap, int); break;
+	    case 'l': __v = va_arg (__ap, long); break;
+	    case 'L': __v = va_arg (__ap, long long); break;
+	    case 'j': __v = va_arg (__ap, intmax_t); break;
+	    case 'z': __v = (ptrdiff_t) va_arg (__ap, size_t); break;
+	    case 't': __v = va_arg (__ap, ptrdiff_t); break;
+	    default: __v = va_arg (__ap, int); break;
+	    }
+	  __u = __v < 0 ? -(unsigned long long) __v : (unsigned long long) __v;
+	  __s = __printf_fast_ullong (__s, __u, 10, NULL);
+	  if (__v < 0)
+	    *--__s = '-';
+	  break;
+	case 'u':
+	case 'o':
+	case 'x':
+	case 'X':
+	  switch (__mod)
+	    {
+	    case 'H': __u = (unsigned char) va_arg (__ap, int); break;
+	    case 'h': __u = (unsigned short) va_arg (__ap, int); break;
+	    case 'l': __u = va_arg (__ap, unsigned long); break;
+	    case 'L': __u = va_arg (__ap, unsigned long long); break;
+	    case 'j': __u = va_arg (__ap, uintmax_t); break;
+	    case 'z': __u = va_arg (__ap, size_t); break;
+	    case 't': __u = (size_t) va_arg (__ap, ptrdiff_t); break;
+	    default: __u = va_arg (__ap, unsigned int); break;
+	    }
+	  __base = __fmt[-1] == 'u' ? 10 : __fmt[-1] == 'o' ? 8 : 16;
+	  __s = __printf_fast_ullong (__s, __u, __base,
+				      __fmt[-1] == 'X' ? "0123456789ABCDEF"
+						       : "0123456789abcdef");
+	  break;
+	default:
+	  return -1;
+	}
+      __n = __tmp + sizeof __tmp - __s;
+      if (__n > (size_t) (__end - __p))
+	return -1;
+      memcpy (__p, __s, __n);
+      __p += __n;
+    }
+}
+
+int
+__wrap__vfprintf_r (struct _reent *__r, FILE *__fp, const char *__fmt,
+		    va_list __ap)
+{
+  char __buf[_PRINTF_FAST_BUFSIZ];
+  va_list __aq;
+  int __len;
+
+  va_copy (__aq, __ap);
+  __len = __printf_fast (__buf, __fmt, __aq);
+  va_end (__aq);
+  /* Empty output still has to report a stream that cannot be written.  */
+  if (__len > 0)
+    return _fwrite_r (__r, __buf, 1, __len, __fp) == (size_t) __len
+	   ? __len : EOF;
+  return __real__vfprintf_r (__r, __fp, __fmt, __ap);
+}
+
+int
+__wrap__svfprintf_r (struct _reent *__r, FILE *__fp, const char *__fmt,
+		     va_list __ap)
+{
+  char __buf[_PRINTF_FAST_BUFSIZ];
+  va_list __aq;
+  int __len = -1, __n;
+
+  /* A string that may grow belongs to asprintf or open_memstream.  */
+  if (!(__fp->_flags & (__SMBF | __SOPT)))
+    {
+      va_copy (__aq, __ap);
+      __len = __printf_fast (__buf, __fmt, __aq);
+      va_end (__aq);
+    }
+  if (__len < 0)
+    return __real__svfprintf_r (__r, __fp, __fmt, __ap);
+  /* Like the original, keep what fits for snprintf and count it all.  */
+  __n = __len < __fp->_w ? __len : __fp->_w;
+  memcpy (__fp->_p, __buf, __n);
+  __fp->_p += __n;
+  __fp->_w -= __n;
+  return __len;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _MACHPRINTF_FAST_H_ */
@@ -0,0 +1,42 @@
+#ifndef	_MACHSEMIHOST_H_
+#define	_MACHSEMIHOST_H_
+
+/* Buffered semihosting I/O, defined by <machine/semihost_io.h> in
+   programs that include it.  */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Write out whatever output is still buffered.  Returns 0, or -1 with
+   errno set if that or an earlier buffered write failed.  It is called
+   at exit, and before any read, seek or close.  */
+extern int semihost_flush (void);
+
+/* Ring buffer for console output.  The target appends at HEAD and the
+   host, reading target memory through the debugger while the target
+   runs, consumes from TAIL and advances it.  Both count bytes from the
+   start, so HEAD - TAIL bytes are pending and the next byte goes to
+   BUF[HEAD % SIZE].  A host tool finds the ring at __semihost_ring,
+   checks MAGIC, and polls.  */
+
+#define SEMIHOST_RING_MAGIC	0x676e6972	/* "ring" */
+
+struct semihost_ring
+{
+  unsigned long magic;
+  unsigned long size;
+  volatile unsigned long head;
+  volatile unsigned long tail;
+  /* Bytes dropped because the ring was full.  */
+  volatile unsigned long dropped;
+  char *buf;
+};
+
+extern struct semihost_ring __semihost_ring;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _MACHSEMIHOST_H_ */
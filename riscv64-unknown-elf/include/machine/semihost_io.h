@@ -0,0 +1,322 @@
+/* machine/semihost_io.h -- buffered replacement for semihosting I/O.  */
+
+#ifndef	_MACHSEMIHOST_IO_H_
+#define	_MACHSEMIHOST_IO_H_
+
+/* Including this file in exactly one source file of a program linked
+   with semihost.specs defines _write, _read, _lseek and _close, so the
+   linker takes them from the program instead of libsemihost.a.  Their
+   versions there make one semihosting trap per call.
+
+   Output is collected in a buffer of _SEMIHOST_BUFSIZ bytes.  Writes to
+   the same descriptor are coalesced there, and the buffer goes to the
+   host in one trap when it fills, when another descriptor is written,
+   or when semihost_flush runs.  semihost_flush is called at exit and
+   before any read, seek or close, so prompts show before input is
+   awaited.  Writes to stderr, and writes of at least _SEMIHOST_BUFSIZ
+   bytes, go straight to the host, so that a message written just
+   before abort or a crash is not lost.  A buffered write that fails on
+   the host is reported by the write or flush that sends it.
+
+   abort reaches _exit without running the atexit handlers; linking
+   with -Wl,--wrap=_exit as well flushes the buffer there too.  Output
+   still buffered when the program stops in any other way is lost.
+
+   Defining _SEMIHOST_RING to a power of two sends output on descriptors
+   1 and 2 to __semihost_ring instead, a ring of that many bytes that a
+   host tool drains while the target runs, without any trap; see
+   <machine/semihost.h>.  When the ring is full, a write waits for the
+   host, or with _SEMIHOST_RING_DROP defined, drops what does not fit.
+
+   The buffer is guarded by a spin lock when the A extension is there;
+   systems that preempt threads should define _SEMIHOST_LOCK and
+   _SEMIHOST_UNLOCK to a sleeping lock instead.  */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <machine/syscall.h>
+#include <machine/semihost.h>
+
+#ifndef _SEMIHOST_BUFSIZ
+#define _SEMIHOST_BUFSIZ 4096
+#endif
+
+#ifndef _SEMIHOST_LOCK
+#ifdef __riscv_atomic
+#define _SEMIHOST_LOCK() \
+  while (__atomic_exchange_n (&__semihost_lock, 1, __ATOMIC_ACQUIRE))
+#define _SEMIHOST_UNLOCK() \
+  __atomic_store_n (&__semihost_lock, 0, __ATOMIC_RELEASE)
+#else
+#define _SEMIHOST_LOCK()
+#define _SEMIHOST_UNLOCK()
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern void __real__exit (int) __attribute__ ((__weak__, __noreturn__));
+
+/* The descriptor table of libsemihost.a.  */
+struct __semihost_fdentry
+{
+  int __handle;
+  off_t __pos;
+};
+
+extern struct __semihost_fdentry *__get_fdentry (int);
+extern void __remove_fdentry (int);
+
+static char __semihost_buf[_SEMIHOST_BUFSIZ];
+static size_t __semihost_len;
+static int __semihost_fd = -1;
+static int __semihost_status;
+static int __semihost_atexit;
+static int __attribute__ ((__unused__)) __semihost_lock;
+
+#ifdef _SEMIHOST_RING
+static char __semihost_ring_buf[_SEMIHOST_RING];
+
+struct semihost_ring __semihost_ring =
+{
+  SEMIHOST_RING_MAGIC, _SEMIHOST_RING, 0, 0, 0, __semihost_ring_buf
+};
+#endif
+
+/* The trap sequence must not straddle a page, hence the alignment.  */
+static inline long
+__semihost_call (long __op, void *__arg)
+{
+  register long __a0 __asm__ ("a0") = __op;
+  register void *__a1 __asm__ ("a1") = __arg;
+
+  __asm__ __volatile__ (".option\tpush\n\t"
+			".option\tnorvc\n\t"
+			".balign\t16\n\t"
+			"slli\tzero, zero, 0x1f\n\t"
+			"ebreak\n\t"
+			"srai\tzero, zero, 0x7\n\t"
+			".option\tpop"
+			: "+r" (__a0) : "r" (__a1) : "memory");
+  return __a0;
+}
+
+static inline int
+__semihost_error (void)
+{
+  errno = __semihost_call (SEMIHOST_errno, NULL);
+  return -1;
+}
+
+static long
+__semihost_write (struct __semihost_fdentry *__e, const void *__p,
+		  size_t __n)
+{
+  long __args[3] = { __e->__handle, (long) __p, (long) __n };
+  long __left = __semihost_call (SEMIHOST_write, __args);
+
+  if (__left < 0)
+    return __semihost_error ();
+  __e->__pos += __n - __left;
+  return __n - __left;
+}
+
+static int
+__semihost_flush_locked (void)
+{
+  struct __semihost_fdentry *__e;
+  int __status = __semihost_status;
+
+  __semihost_status = 0;
+  if (__semihost_len)
+    {
+      if (!(__e = __get_fdentry (__semihost_fd))
+	  || __semihost_write (__e, __semihost_buf, __semihost_len)
+	     != (long) __semihost_len)
+	__status = -1;
+      __semihost_len = 0;
+    }
+  __semihost_fd = -1;
+  return __status;
+}
+
+int
+semihost_flush (void)
+{
+  int __status;
+
+  _SEMIHOST_LOCK ();
+  __status = __semihost_flush_locked ();
+  _SEMIHOST_UNLOCK ();
+  return __status;
+}
+
+static void
+__semihost_exit_flush (void)
+{
+  semihost_flush ();
+}
+
+/* For -Wl,--wrap=_exit, which abort calls directly.  */
+void
+__wrap__exit (int __status)
+{
+  semihost_flush ();
+  __real__exit (__status);
+}
+
+#ifdef _SEMIHOST_RING
+static _ssize_t
+__semihost_ring_write (const char *__p, size_t __n)
+{
+  struct semihost_ring *__rg = &__semihost_ring;
+  size_t __done = 0, __room, __at, __k;
+
+  while (__done < __n)
+    {
+      __room = _SEMIHOST_RING - (__rg->head - __rg->tail);
+      if (!__room)
+	{
+#ifdef _SEMIHOST_RING_DROP
+	  __rg->dropped += __n - __done;
+	  break;
+#else
+	  continue;
+#endif
+	}
+      __atomic_thread_fence (__ATOMIC_ACQUIRE);
+      __at = __rg->head % _SEMIHOST_RING;
+      __k = __n - __done;
+      if (__k > __room)
+	__k = __room;
+      if (__k > _SEMIHOST_RING - __at)
+	__k = _SEMIHOST_RING - __at;
+      memcpy (&__semihost_ring_buf[__at], __p + __done, __k);
+      __atomic_thread_fence (__ATOMIC_RELEASE);
+      __rg->head += __k;
+      __done += __k;
+    }
+  return __n;
+}
+#endif
+
+_ssize_t
+_write (int __fd, const void *__p, size_t __n)
+{
+  struct __semihost_fdentry *__e;
+  _ssize_t __ret = __n;
+
+  _SEMIHOST_LOCK ();
+#ifdef _SEMIHOST_RING
+  if (__fd == STDOUT_FILENO || __fd == STDERR_FILENO)
+    {
+      __ret = __semihost_ring_write ((const char *) __p, __n);
+      _SEMIHOST_UNLOCK ();
+      return __ret;
+    }
+#endif
+  if (!(__e = __get_fdentry (__fd)))
+    __ret = -1;
+  else if ((__fd != __semihost_fd
+	    || __semihost_len + __n > _SEMIHOST_BUFSIZ)
+	   && __semihost_flush_locked () < 0)
+    __ret = -1;
+  else if (__n >= _SEMIHOST_BUFSIZ || __fd == STDERR_FILENO)
+    __ret = __semihost_write (__e, __p, __n);
+  else
+    {
+      if (!__semihost_atexit)
+	__semihost_atexit = !atexit (__semihost_exit_flush);
+      memcpy (&__semihost_buf[__semihost_len], __p, __n);
+      __semihost_len += __n;
+      __semihost_fd = __fd;
+    }
+  _SEMIHOST_UNLOCK ();
+  return __ret;
+}
+
+_ssize_t
+_read (int __fd, void *__p, size_t __n)
+{
+  struct __semihost_fdentry *__e;
+  long __args[3], __left;
+
+  if (semihost_flush () < 0 || !(__e = __get_fdentry (__fd)))
+    return -1;
+  __args[0] = __e->__handle;
+  __args[1] = (long) __p;
+  __args[2] = (long) __n;
+  if ((__left = __semihost_call (SEMIHOST_read, __args)) < 0)
+    return __semihost_error ();
+  __e->__pos += __n - __left;
+  return __n - __left;
+}
+
+off_t
+_lseek (int __fd, off_t __off, int __whence)
+{
+  struct __semihost_fdentry *__e;
+  long __args[2], __len;
+  off_t __pos;
+
+  if (semihost_flush () < 0 || !(__e = __get_fdentry (__fd)))
+    return -1;
+  switch (__whence)
+    {
+    case SEEK_SET:
+      __pos = __off;
+      break;
+    case SEEK_CUR:
+      __pos = __e->__pos + __off;
+      break;
+    case SEEK_END:
+      __args[0] = __e->__handle;
+      if ((__len = __semihost_call (SEMIHOST_flen, __args)) < 0)
+	return __semihost_error ();
+      __pos = __len + __off;
+      break;
+    default:
+      errno = EINVAL;
+      return -1;
+    }
+  if (__pos < 0)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+  if (__pos == __e->__pos && __whence == SEEK_CUR)
+    return __pos;
+  __args[0] = __e->__handle;
+  __args[1] = __pos;
+  if (__semihost_call (SEMIHOST_seek, __args) < 0)
+    return __semihost_error ();
+  return __e->__pos = __pos;
+}
+
+int
+_close (int __fd)
+{
+  struct __semihost_fdentry *__e;
+  long __args[1];
+  int __status = semihost_flush ();
+
+  if (!(__e = __get_fdentry (__fd)))
+    return -1;
+  __args[0] = __e->__handle;
+  if (__semihost_call (SEMIHOST_close, __args) < 0)
+    return __semihost_error ();
+  __remove_fdentry (__fd);
+  return __status;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _MACHSEMIHOST_IO_H_ */
@@ -295,6 +295,7 @@ void *	_malloc_r (struct _reent *, size_t) _NOTHROW;
 void *	_calloc_r (struct _reent *, size_t, size_t) _NOTHROW;
 void	_free_r (struct _reent *, void *) _NOTHROW;
 void *	_realloc_r (struct _reent *, void *, size_t) _NOTHROW;
+void *	_memalign_r (struct _reent *, size_t, size_t) _NOTHROW;
 void	_mstats_r (struct _reent *, char *);
 #endif
 int	_system_r (struct _reent *, const char *);
@@ -336,6 +337,48 @@ _Noreturn void
 	quick_exit(int);
 #endif /* __ISO_C_VISIBLE >= 2011 */
 
+/* posix_memalign is not in libc.a, and the aligned_alloc there calls it,
+   so with GCC both are defined inline on top of _memalign_r, which gives
+   the unused head and tail of its block back to the heap.  The inline
+   bodies never emit a symbol; <machine/mallocr.h> defines the out-of-line
+   versions for programs that take their address.  */
+#if defined (__GNUC__) && __GNUC_PREREQ (4, 2) && !defined (__CYGWIN__)
+#define __STDLIB_MEMALIGN_INLINE \
+	extern __inline__ _ATTRIBUTE ((__gnu_inline__, __always_inline__))
+#if __POSIX_VISIBLE >= 200112
+__STDLIB_MEMALIGN_INLINE int
+posix_memalign (void **__memptr, size_t __align, size_t __size)
+{
+  struct _reent *__r = _REENT;
+  int __errno_saved = __r->_errno;
+  void *__p;
+
+  if (__align == 0 || (__align & (__align - 1)) != 0
+      || __align % sizeof (void *) != 0)
+    return 22;	/* EINVAL */
+  __p = _memalign_r (__r, __align, __size);
+  __r->_errno = __errno_saved;
+  if (__p == NULL && __size != 0)
+    return 12;	/* ENOMEM */
+  *__memptr = __p;
+  return 0;
+}
+#endif
+#if __ISO_C_VISIBLE >= 2011
+__STDLIB_MEMALIGN_INLINE void *
+aligned_alloc (size_t __align, size_t __size)
+{
+  if (__align == 0 || (__align & (__align - 1)) != 0)
+    {
+      _REENT->_errno = 22;	/* EINVAL */
+      return NULL;
+    }
+  return _memalign_r (_REENT, __align, __size);
+}
+#endif
+#undef __STDLIB_MEMALIGN_INLINE
+#endif
+
 _END_STD_C
 
 #if __SSP_FORTIFY_LEVEL > 0